@@ -0,0 +1,44 @@
+#include "AtlasPacker.hpp"
+
+AtlasPacker::AtlasPacker(int width, int height, int padding)
+	: width(width), height(height), padding(padding), layers(0), layer_top(0) {
+}
+
+bool AtlasPacker::Pack(int rect_width, int rect_height, AtlasRect& rect) {
+	int padded_width = rect_width + 2 * padding;
+	int padded_height = rect_height + 2 * padding;
+
+	if (padded_width > width || padded_height > height) {
+		return false;
+	}
+
+	rect.width = rect_width;
+	rect.height = rect_height;
+
+	// First shelf that is tall enough and has room left
+	for (Shelf& shelf : shelves) {
+		if (padded_height <= shelf.height && shelf.used + padded_width <= width) {
+			rect.x = shelf.used + padding;
+			rect.y = shelf.y + padding;
+			rect.layer = shelf.layer;
+
+			shelf.used += padded_width;
+			return true;
+		}
+	}
+
+	// Opens a shelf on the newest layer, or on a new layer if it's full
+	if (layers == 0 || layer_top + padded_height > height) {
+		layers++;
+		layer_top = 0;
+	}
+
+	Shelf shelf = { layers - 1, layer_top, padded_height, padded_width };
+	shelves.push_back(shelf);
+	layer_top += padded_height;
+
+	rect.x = padding;
+	rect.y = shelf.y + padding;
+	rect.layer = shelf.layer;
+	return true;
+}
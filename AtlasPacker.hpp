@@ -0,0 +1,36 @@
+#pragma once
+
+#include <vector>
+
+// Where a rectangle ended up, in pixels of its layer
+struct AtlasRect {
+	int x, y;
+	int width, height;
+	int layer;
+};
+
+// Shelf packer, rectangles go left to right on horizontal shelves and a new layer is
+// opened when nothing fits. Packing tallest first keeps shelves tight
+class AtlasPacker {
+	public:
+		int width, height;
+		// Empty pixels kept around every rectangle so filtering doesn't bleed neighbours in
+		int padding;
+		int layers;
+
+		AtlasPacker(int width, int height, int padding = 2);
+
+		// False only if the rectangle can't fit an empty layer
+		bool Pack(int width, int height, AtlasRect& rect);
+
+	private:
+		struct Shelf {
+			int layer;
+			int y, height;
+			int used;
+		};
+
+		std::vector<Shelf> shelves;
+		// Top of the last shelf of the newest layer
+		int layer_top;
+};
@@ -0,0 +1,12 @@
+#include "BakedTexture.hpp"
+
+#include <iostream>
+
+bool openBakedTexture(const char* file_name, MappedFile& file, BakedTextureHeader& header, const BakedTextureLevel*& levels) {
+	if (!file.Open(file_name)) {
+		std::cout << "ERROR::TEXTURE::BAKED_LOADING_FAILED " << file_name << std::endl;
+		return false;
+	}
+
+	return validateBakedTexture(file.data, file.size, file_name, header, levels);
+}
@@ -0,0 +1,9 @@
+#pragma once
+
+#include "BakedTextureFormat.hpp"
+#include "MappedFile.hpp"
+
+// Runtime side of the .ptex container. Maps file and validates it, false (error printed)
+// if it is missing or anything in it is off. levels then points into file's mapping,
+// which has to stay open while they are read
+bool openBakedTexture(const char* file_name, MappedFile& file, BakedTextureHeader& header, const BakedTextureLevel*& levels);
@@ -0,0 +1,63 @@
+#include "BakedTextureFormat.hpp"
+
+#include <cstring>
+#include <iostream>
+
+uint32_t bakedTextureLevels(uint32_t width, uint32_t height) {
+	uint32_t levels = 1;
+
+	while (width > 1 || height > 1) {
+		width = width > 1 ? width / 2 : 1;
+		height = height > 1 ? height / 2 : 1;
+		levels++;
+	}
+
+	return levels;
+}
+
+bool validateBakedTexture(const unsigned char* data, std::size_t size, const char* file_name,
+	BakedTextureHeader& header, const BakedTextureLevel*& levels) {
+
+	if (size < sizeof(BakedTextureHeader)) {
+		std::cout << "ERROR::TEXTURE::BAKED_TRUNCATED " << file_name << std::endl;
+		return false;
+	}
+
+	std::memcpy(&header, data, sizeof(header));
+
+	// Levels is bounded before it sizes the table, so nothing below can overflow
+	bool valid = std::memcmp(header.magic, baked_texture_magic, 4) == 0 && header.version == baked_texture_version &&
+		header.width > 0 && header.height > 0 && header.width <= 1u << 16 && header.height <= 1u << 16 &&
+		(header.compressed_format != 0 || (header.channels >= 1 && header.channels <= 4)) &&
+		header.levels > 0 && header.levels <= bakedTextureLevels(header.width, header.height);
+
+	if (!valid || sizeof(header) + header.levels * sizeof(BakedTextureLevel) > size) {
+		std::cout << "ERROR::TEXTURE::BAKED_INVALID " << file_name << std::endl;
+		return false;
+	}
+
+	levels = (const BakedTextureLevel*)(data + sizeof(header));
+
+	uint32_t width = header.width, height = header.height;
+
+	for (uint32_t i = 0; i < header.levels; i++) {
+		const BakedTextureLevel& level = levels[i];
+
+		if (level.width != width || level.height != height ||
+			(header.compressed_format == 0 && level.size < (uint64_t)width * height * header.channels)) {
+			std::cout << "ERROR::TEXTURE::BAKED_INVALID " << file_name << std::endl;
+			return false;
+		}
+
+		// Written so a huge offset or size can't wrap around
+		if (level.offset > size || level.size > size - level.offset) {
+			std::cout << "ERROR::TEXTURE::BAKED_TRUNCATED " << file_name << std::endl;
+			return false;
+		}
+
+		width = width > 1 ? width / 2 : 1;
+		height = height > 1 ? height / 2 : 1;
+	}
+
+	return true;
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Baked texture container (.ptex), every mip level already in upload layout so loading
+// is a memory map and a copy, no decoding. Layout: BakedTextureHeader, one
+// BakedTextureLevel per level, then the level data. Needs no GL, the baker writes it
+// from PongHeadless
+const char baked_texture_magic[4] = { 'P', 'T', 'E', 'X' };
+const uint32_t baked_texture_version = 1;
+
+// Level data starts on this boundary
+const uint32_t baked_texture_alignment = 16;
+
+struct BakedTextureHeader {
+	char magic[4];
+	uint32_t version;
+	uint32_t width, height;
+	// 1 to 4, 8 bits each, ignored for compressed data
+	uint32_t channels;
+	uint32_t levels;
+	// 0 for uncompressed, otherwise the GL compressed internal format of every level
+	uint32_t compressed_format;
+	uint32_t reserved;
+};
+
+struct BakedTextureLevel {
+	uint64_t offset;
+	uint64_t size;
+	uint32_t width, height;
+};
+
+// Levels of a full mip chain down to 1x1
+uint32_t bakedTextureLevels(uint32_t width, uint32_t height);
+
+// Checks the header and level table of a whole .ptex in memory: known version, 1 to 4
+// channels, no more levels than the size allows, each level half the previous one and
+// inside the data, uncompressed levels large enough for their size. False (error printed
+// with file_name) if anything is off, levels then points into data
+bool validateBakedTexture(const unsigned char* data, std::size_t size, const char* file_name,
+	BakedTextureHeader& header, const BakedTextureLevel*& levels);
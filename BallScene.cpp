@@ -0,0 +1,24 @@
+#include "BallScene.hpp"
+
+#include "Random.hpp"
+
+BallScene::BallScene(std::size_t count, float width, float height)
+	: width(width), height(height), positions(count), velocities(count) {
+
+	for (std::size_t i = 0; i < count; i++) {
+		uint64_t bits = randomBits(0, i, 0);
+
+		positions[i] = glm::vec2(randomRange((uint32_t)bits, 0, (int32_t)width), randomRange((uint32_t)(bits >> 32), 0, (int32_t)height));
+		ServeVelocity velocity = serveVelocity(0, i, 1);
+		velocities[i] = glm::vec2(velocity.x, velocity.y);
+	}
+}
+
+void BallScene::Step(float dt) {
+	for (std::size_t i = 0; i < positions.size(); i++) {
+		positions[i] += velocities[i] * dt;
+
+		if (positions[i].x < 0.0f || positions[i].x > width) velocities[i].x = -velocities[i].x;
+		if (positions[i].y < 0.0f || positions[i].y > height) velocities[i].y = -velocities[i].y;
+	}
+}
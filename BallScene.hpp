@@ -0,0 +1,20 @@
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+// Balls bouncing around a width x height area, the scene the rendering benchmarks draw.
+// The same count and size always give the same scene
+class BallScene {
+	public:
+		float width, height;
+		std::vector<glm::vec2> positions;
+		std::vector<glm::vec2> velocities;
+
+		BallScene(std::size_t count, float width, float height);
+
+		// Moves every ball dt seconds, bouncing off every edge
+		void Step(float dt);
+};
@@ -0,0 +1,108 @@
+#include "BatchScheduler.hpp"
+
+#include <algorithm>
+#include <atomic>
+
+// Shared by every slice of one simulateBatch call
+struct BatchJob {
+	WorkStealingPool& pool;
+	MatchBatch& batch;
+	float dt;
+	BatchInput input;
+
+	unsigned int rallies_per_match;
+	unsigned long long target_rallies;
+	std::atomic<unsigned long long> rallies;
+};
+
+std::size_t batchChunkSize(std::size_t count, unsigned int workers) {
+	// Every per match array of MatchBatch
+	const std::size_t match_bytes = 8 * sizeof(float) + 2 * sizeof(signed char) + sizeof(int) + 2 * sizeof(unsigned int);
+
+	// Whole cache lines of floats, so neighbouring chunks don't false share and
+	// only the last chunk runs a scalar tail
+	const std::size_t line = cache_line_size / sizeof(float);
+
+	std::size_t chunk = chunk_cache_bytes / match_bytes;
+
+	if (workers > 1) {
+		chunk = std::min(chunk, (count + workers - 1) / workers);
+	}
+
+	return std::max(line, chunk - chunk % line);
+}
+
+static bool matchFinished(const MatchBatch& batch, std::size_t i, unsigned int rallies_per_match) {
+	return batch.left_score[i] + batch.right_score[i] >= rallies_per_match;
+}
+
+static unsigned long long rangeRallies(const MatchBatch& batch, std::size_t begin, std::size_t end) {
+	unsigned long long rallies = 0;
+
+	for (std::size_t i = begin; i < end; i++) {
+		rallies += batch.left_score[i] + batch.right_score[i];
+	}
+
+	return rallies;
+}
+
+// Steps the unfinished matches of [begin, end) for slice_ticks, then queues the next slice
+// if there is anything left to do. A rally takes far longer than a slice, so which matches
+// are finished is decided once per slice
+static void submitSlice(BatchJob& job, std::size_t begin, std::size_t end) {
+	job.pool.Submit([&job, begin, end] {
+		if (job.rallies >= job.target_rallies) {
+			return;
+		}
+
+		MatchBatch& batch = job.batch;
+		unsigned long long before = rangeRallies(batch, begin, end);
+		unsigned long long match_ticks = 0;
+		bool unfinished = false;
+
+		// Runs of consecutive unfinished matches, finished ones are skipped
+		std::size_t run = begin;
+		while (run < end) {
+			while (run < end && matchFinished(batch, run, job.rallies_per_match)) run++;
+
+			std::size_t run_end = run;
+			while (run_end < end && !matchFinished(batch, run_end, job.rallies_per_match)) run_end++;
+
+			if (run < run_end) {
+				for (unsigned int tick = 0; tick < slice_ticks; tick++) {
+					job.input(batch, run, run_end);
+					batch.Step(job.dt, run, run_end);
+				}
+
+				match_ticks += (unsigned long long)slice_ticks * (run_end - run);
+				unfinished = true;
+			}
+
+			run = run_end;
+		}
+
+		WorkStealingPool::AddWork(match_ticks);
+
+		unsigned long long rallies = job.rallies += rangeRallies(batch, begin, end) - before;
+
+		if (unfinished && rallies < job.target_rallies) {
+			submitSlice(job, begin, end);
+		}
+	});
+}
+
+void simulateBatch(WorkStealingPool& pool, MatchBatch& batch, float dt, unsigned long long target_rallies, BatchInput input) {
+	BatchJob job = { pool, batch, dt, input, 0, target_rallies, { 0 } };
+
+	// Counts from the current state, so a batch can be simulated further
+	job.rallies = batch.Rallies();
+	job.rallies_per_match = (unsigned int)((target_rallies + batch.count - 1) / batch.count);
+
+	const std::size_t chunk = batchChunkSize(batch.count, pool.Size());
+
+	for (std::size_t begin = 0; begin < batch.count; begin += chunk) {
+		submitSlice(job, begin, std::min(begin + chunk, batch.count));
+	}
+
+	pool.Wait();
+}
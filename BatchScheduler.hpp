@@ -0,0 +1,26 @@
+#pragma once
+
+#include <cstddef>
+
+#include "MatchBatch.hpp"
+#include "ThreadPool.hpp"
+
+// Sets paddle inputs for matches in [begin, end) before each tick
+typedef void (*BatchInput)(MatchBatch& batch, std::size_t begin, std::size_t end);
+
+// Bytes of match state a chunk should fit in, about one L1 data cache
+const std::size_t chunk_cache_bytes = 32 * 1024;
+
+// Ticks a slice steps its chunk before handing the worker back to the pool
+const unsigned int slice_ticks = 64;
+
+// Matches per chunk, so a chunk's whole SoA state stays in cache while it is stepped,
+// made smaller when needed so every worker gets at least one chunk
+std::size_t batchChunkSize(std::size_t count, unsigned int workers);
+
+// Shards the batch into chunks and steps them on the pool in slices of slice_ticks until
+// target_rallies rallies have been played in total. Matches stop stepping once they reach
+// their share of the target and a slice requeues itself only while its chunk still has
+// matches short of it, so idle workers can steal them. The total is only checked between
+// slices, a run can go past the target by up to one slice of rallies per chunk
+void simulateBatch(WorkStealingPool& pool, MatchBatch& batch, float dt, unsigned long long target_rallies, BatchInput input);
@@ -0,0 +1,58 @@
+#include "BufferBenchmark.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "GpuBuffer.hpp"
+#include "FixedTimestep.hpp"
+
+void benchmarkBufferUpdates() {
+	const std::size_t instance_counts[] = { 1, 1000, 1000000 };
+	const BufferUpdate updates[] = { BUFFER_SUBDATA, BUFFER_ORPHAN, BUFFER_MAP_UNSYNCHRONIZED, BUFFER_PERSISTENT };
+
+	std::cout << std::left << std::setw(12) << "Instances" << std::setw(22) << "Strategy"
+		<< std::setw(18) << "CPU us/update" << "Total us/update" << std::endl;
+
+	for (std::size_t instances : instance_counts) {
+		std::vector<glm::vec2> data(instances, glm::vec2(1.0f));
+		GLsizeiptr size = instances * sizeof(glm::vec2);
+
+		// Same number of bytes moved per run, at least a few dozen updates
+		unsigned int iterations = instances >= 1000000 ? 60 : 1000;
+
+		// The GPU reads every update by copying it here, like a draw would
+		GLuint sink;
+		glCreateBuffers(1, &sink);
+		glNamedBufferStorage(sink, size, NULL, 0);
+
+		for (BufferUpdate update : updates) {
+			GpuBuffer<glm::vec2> buffer(instances, update, data.data());
+			glFinish();
+
+			uint64_t start = monotonicNanoseconds();
+
+			for (unsigned int i = 0; i < iterations; i++) {
+				data[0].x = (float)i;
+
+				GLintptr offset = buffer.Update(data.data(), instances);
+				glCopyNamedBufferSubData(buffer.ID, sink, offset, 0, size);
+				buffer.Fence();
+			}
+
+			uint64_t submitted = monotonicNanoseconds();
+			glFinish();
+			uint64_t finished = monotonicNanoseconds();
+
+			std::cout << std::left << std::setw(12) << instances << std::setw(22) << bufferUpdateName(update)
+				<< std::setw(18) << (submitted - start) / 1000.0 / iterations
+				<< (finished - start) / 1000.0 / iterations << std::endl;
+
+			buffer.Delete();
+		}
+
+		glDeleteBuffers(1, &sink);
+	}
+}
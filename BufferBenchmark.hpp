@@ -0,0 +1,5 @@
+#pragma once
+
+// Times every BufferUpdate strategy at 1, 1k and 1M instances with a GPU copy reading the
+// buffer after each update, so waits on in-flight data show up. Needs a current context
+void benchmarkBufferUpdates();
@@ -0,0 +1,96 @@
+#include "Collision.hpp"
+
+#include <cmath>
+#include <limits>
+
+const float never = std::numeric_limits<float>::infinity();
+
+float sweptBounds(float position, float velocity, float low, float high) {
+	if (velocity == 0.0f) {
+		return never;
+	}
+
+	float target = velocity > 0 ? high : low;
+	return std::fmax((target - position) / velocity, 0.0f);
+}
+
+bool sweptCircleBox(glm::vec2 center, glm::vec2 velocity, float radius,
+	glm::vec2 box_center, glm::vec2 box_half_size, float box_velocity,
+	float& time, bool& horizontal) {
+
+	// Works in the box's frame, the circle center against the box grown by the radius
+	glm::vec2 relative = center - box_center;
+	glm::vec2 relative_velocity = { velocity.x, velocity.y - box_velocity };
+	glm::vec2 extent = box_half_size + radius;
+
+	float enter[2], exit[2];
+
+	for (int axis = 0; axis < 2; axis++) {
+		if (relative_velocity[axis] != 0.0f) {
+			float a = (-extent[axis] - relative[axis]) / relative_velocity[axis];
+			float b = (extent[axis] - relative[axis]) / relative_velocity[axis];
+			enter[axis] = std::fmin(a, b);
+			exit[axis] = std::fmax(a, b);
+		}
+		else if (std::abs(relative[axis]) < extent[axis]) {
+			enter[axis] = -never;
+			exit[axis] = never;
+		}
+		else {
+			return false;
+		}
+	}
+
+	float t_enter = std::fmax(enter[0], enter[1]);
+	float t_exit = std::fmin(exit[0], exit[1]);
+
+	// Never touching, or moving out
+	if (t_enter >= t_exit || t_exit < 0.0f) {
+		return false;
+	}
+
+	glm::vec2 contact = relative + relative_velocity * t_enter;
+
+	// Inside the grown box already. Off a corner that can still be a miss of the real,
+	// rounded shape, the corner test below tells. Anywhere else it is a real overlap
+	// (e.g. just bounced), which Game::Separate deals with
+	if (t_enter < 0.0f) {
+		if (std::abs(relative.x) <= box_half_size.x || std::abs(relative.y) <= box_half_size.y) {
+			return false;
+		}
+
+		contact = relative;
+	}
+
+	// Entering through a corner of the grown box, the real shape there is a quarter
+	// circle around the box corner
+	if (std::abs(contact.x) > box_half_size.x && std::abs(contact.y) > box_half_size.y) {
+		glm::vec2 corner = { std::copysign(box_half_size.x, contact.x), std::copysign(box_half_size.y, contact.y) };
+		glm::vec2 offset = relative - corner;
+
+		// Solves |offset + relative_velocity * t| = radius
+		float a = glm::dot(relative_velocity, relative_velocity);
+		float b = glm::dot(offset, relative_velocity);
+		float c = glm::dot(offset, offset) - radius * radius;
+		float discriminant = b * b - a * c;
+
+		if (a == 0.0f || discriminant < 0.0f || c < 0.0f) {
+			return false;
+		}
+
+		float t = (-b - std::sqrt(discriminant)) / a;
+		if (t < 0.0f || t >= t_exit) {
+			return false;
+		}
+
+		glm::vec2 normal = offset + relative_velocity * t;
+
+		time = t;
+		horizontal = std::abs(normal.x) > std::abs(normal.y);
+		return true;
+	}
+
+	time = t_enter;
+	horizontal = enter[0] > enter[1];
+	return true;
+}
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <glm/glm.hpp>
+
+// Continuous (swept) collision tests, they return the exact time of impact inside
+// a step instead of checking overlap once per frame
+
+enum SimulationEvent {
+	EVENT_NONE,
+	EVENT_WALL,
+	EVENT_GOAL,
+	EVENT_PADDLE,
+	EVENT_PADDLE_STOP
+};
+
+// Earliest upcoming event of a match and how to resolve it
+struct Contact {
+	SimulationEvent event;
+	float time;
+
+	// Paddle that was hit or stopped
+	int paddle;
+	// Paddle hit on its left/right side (true) or top/bottom (false)
+	bool horizontal;
+	// Wall the ball went through, left (0) or right (1)
+	bool winner;
+};
+
+// Time until position reaches whichever of low/high it is moving towards, 0 if already
+// past it, infinity when not moving
+float sweptBounds(float position, float velocity, float low, float high);
+
+// Circle moving at velocity against a box moving vertically at box_velocity. On a hit
+// returns true with the time of impact and which face (or corner) was touched
+bool sweptCircleBox(glm::vec2 center, glm::vec2 velocity, float radius,
+	glm::vec2 box_center, glm::vec2 box_half_size, float box_velocity,
+	float& time, bool& horizontal);
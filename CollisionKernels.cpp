@@ -0,0 +1,326 @@
+#include "CollisionKernels.hpp"
+#include "MatchBatch.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <random>
+
+#include <glm/simd/platform.h>
+
+// x86 kernels are compiled whenever the target has SSE2, the wider ones are only
+// called after the CPU reports support for them at runtime
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+#	define COLLISION_KERNELS_X86
+#	include <immintrin.h>
+#	if GLM_COMPILER & GLM_COMPILER_VC
+#		define TARGET_SSE41
+#		define TARGET_AVX2
+#	else
+#		define TARGET_SSE41 __attribute__((target("sse4.1")))
+#		define TARGET_AVX2 __attribute__((target("avx2")))
+#	endif
+#endif
+
+// Distance from paddle center at which the ball starts touching it
+const float hit_extent_x = paddle_width / 2 + ball_radius;
+const float hit_extent_y = paddle_height / 2 + ball_radius;
+
+void collidePaddlesScalar(MatchBatch& batch, std::size_t begin, std::size_t end) {
+	const float paddle_x[2] = { paddle_margin, batch.width - paddle_margin };
+
+	for (std::size_t i = begin; i < end; i++) {
+		if (batch.collision_cooldown[i] > 0) {
+			batch.collision_cooldown[i]--;
+		}
+
+		if (batch.collision_cooldown[i] != 0) {
+			continue;
+		}
+
+		const float paddle_y[2] = { batch.left_paddle_y[i], batch.right_paddle_y[i] };
+		const float paddle_velocity[2] = { batch.left_paddle_velocity[i], batch.right_paddle_velocity[i] };
+
+		for (int lr = 0; lr < 2; lr++) {
+			float distance_x = std::abs(batch.ball_x[i] - paddle_x[lr]) - hit_extent_x;
+			float distance_y = std::abs(batch.ball_y[i] - paddle_y[lr]) - hit_extent_y;
+
+			if (distance_x < 0 && distance_y < 0) {
+				if (distance_x > distance_y) {
+					batch.velocity_x[i] *= -1;
+					batch.ball_x[i] += (distance_x + 0.1f) * (batch.ball_x[i] < paddle_x[lr] ? -1 : 1);
+				}
+				else {
+					batch.velocity_y[i] *= -1;
+					batch.ball_y[i] += (distance_y + 0.1f) * (batch.ball_y[i] < paddle_y[lr] ? -1 : 1);
+				}
+
+				// Speed up ball
+				float vx = batch.velocity_x[i] * 1.05f;
+				float vy = batch.velocity_y[i] + 0.5f * paddle_velocity[lr];
+
+				// Checks for ball minimum and maximum velocities
+				if (std::abs(vy) < ball_min_velocity) vy = (vy > 0) ? ball_min_velocity : -ball_min_velocity;
+				if (std::abs(vy) > ball_max_velocity) vy = (vy > 0) ? ball_max_velocity : -ball_max_velocity;
+				if (std::abs(vx) < ball_min_velocity) vx = (vx > 0) ? ball_min_velocity : -ball_min_velocity;
+				if (std::abs(vx) > ball_max_velocity) vx = (vx > 0) ? ball_max_velocity : -ball_max_velocity;
+
+				batch.velocity_x[i] = vx;
+				batch.velocity_y[i] = vy;
+
+				batch.collision_cooldown[i] = collision_threshold;
+				break;
+			}
+		}
+	}
+}
+
+#ifdef COLLISION_KERNELS_X86
+
+// Same as the scalar clamp, blend picks the clamped value only where it would have branched
+TARGET_SSE41 static inline __m128 clampVelocity(__m128 v) {
+	const __m128 sign = _mm_set1_ps(-0.0f);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 min = _mm_set1_ps(ball_min_velocity);
+	const __m128 max = _mm_set1_ps(ball_max_velocity);
+
+	__m128 signed_min = _mm_blendv_ps(_mm_xor_ps(min, sign), min, _mm_cmpgt_ps(v, zero));
+	v = _mm_blendv_ps(v, signed_min, _mm_cmplt_ps(_mm_andnot_ps(sign, v), min));
+
+	__m128 signed_max = _mm_blendv_ps(_mm_xor_ps(max, sign), max, _mm_cmpgt_ps(v, zero));
+	return _mm_blendv_ps(v, signed_max, _mm_cmpgt_ps(_mm_andnot_ps(sign, v), max));
+}
+
+TARGET_SSE41 static void collidePaddlesSSE41(MatchBatch& batch, std::size_t begin, std::size_t end) {
+	const __m128 sign = _mm_set1_ps(-0.0f);
+	const __m128 zero = _mm_setzero_ps();
+	const __m128 push_margin = _mm_set1_ps(0.1f);
+	const __m128 left_x = _mm_set1_ps(paddle_margin);
+	const __m128 right_x = _mm_set1_ps(batch.width - paddle_margin);
+	const __m128 extent_x = _mm_set1_ps(hit_extent_x);
+	const __m128 extent_y = _mm_set1_ps(hit_extent_y);
+	const __m128i zero_i = _mm_setzero_si128();
+	const __m128i threshold = _mm_set1_epi32(collision_threshold);
+
+	std::size_t i = begin;
+
+	for (; i + 4 <= end; i += 4) {
+		__m128 bx = _mm_loadu_ps(&batch.ball_x[i]);
+		__m128 by = _mm_loadu_ps(&batch.ball_y[i]);
+		__m128 vx = _mm_loadu_ps(&batch.velocity_x[i]);
+		__m128 vy = _mm_loadu_ps(&batch.velocity_y[i]);
+		__m128 left_y = _mm_loadu_ps(&batch.left_paddle_y[i]);
+		__m128 right_y = _mm_loadu_ps(&batch.right_paddle_y[i]);
+		__m128i cooldown = _mm_loadu_si128((const __m128i*)&batch.collision_cooldown[i]);
+
+		// Counts cooldown down, compare gives -1 where it is still positive
+		cooldown = _mm_add_epi32(cooldown, _mm_cmpgt_epi32(cooldown, zero_i));
+		__m128 ready = _mm_castsi128_ps(_mm_cmpeq_epi32(cooldown, zero_i));
+
+		__m128 left_dx = _mm_sub_ps(_mm_andnot_ps(sign, _mm_sub_ps(bx, left_x)), extent_x);
+		__m128 left_dy = _mm_sub_ps(_mm_andnot_ps(sign, _mm_sub_ps(by, left_y)), extent_y);
+		__m128 right_dx = _mm_sub_ps(_mm_andnot_ps(sign, _mm_sub_ps(bx, right_x)), extent_x);
+		__m128 right_dy = _mm_sub_ps(_mm_andnot_ps(sign, _mm_sub_ps(by, right_y)), extent_y);
+
+		// Left paddle wins ties, right is only checked where left missed
+		__m128 hit_left = _mm_and_ps(ready, _mm_and_ps(_mm_cmplt_ps(left_dx, zero), _mm_cmplt_ps(left_dy, zero)));
+		__m128 hit_right = _mm_andnot_ps(hit_left, _mm_and_ps(ready, _mm_and_ps(_mm_cmplt_ps(right_dx, zero), _mm_cmplt_ps(right_dy, zero))));
+		__m128 hit = _mm_or_ps(hit_left, hit_right);
+
+		if (_mm_movemask_ps(hit) == 0) {
+			_mm_storeu_si128((__m128i*)&batch.collision_cooldown[i], cooldown);
+			continue;
+		}
+
+		__m128 paddle_x = _mm_blendv_ps(right_x, left_x, hit_left);
+		__m128 paddle_y = _mm_blendv_ps(right_y, left_y, hit_left);
+		__m128 paddle_velocity = _mm_blendv_ps(_mm_loadu_ps(&batch.right_paddle_velocity[i]), _mm_loadu_ps(&batch.left_paddle_velocity[i]), hit_left);
+		__m128 dx = _mm_blendv_ps(right_dx, left_dx, hit_left);
+		__m128 dy = _mm_blendv_ps(right_dy, left_dy, hit_left);
+
+		// Horizontal (left/right of paddle) or vertical (top/bottom) hit
+		__m128 horizontal = _mm_and_ps(hit, _mm_cmpgt_ps(dx, dy));
+		__m128 vertical = _mm_andnot_ps(horizontal, hit);
+
+		__m128 push_x = _mm_xor_ps(_mm_add_ps(dx, push_margin), _mm_and_ps(_mm_cmplt_ps(bx, paddle_x), sign));
+		__m128 push_y = _mm_xor_ps(_mm_add_ps(dy, push_margin), _mm_and_ps(_mm_cmplt_ps(by, paddle_y), sign));
+
+		bx = _mm_blendv_ps(bx, _mm_add_ps(bx, push_x), horizontal);
+		by = _mm_blendv_ps(by, _mm_add_ps(by, push_y), vertical);
+		vx = _mm_blendv_ps(vx, _mm_xor_ps(vx, sign), horizontal);
+		vy = _mm_blendv_ps(vy, _mm_xor_ps(vy, sign), vertical);
+
+		// Speed up ball
+		__m128 new_vx = clampVelocity(_mm_mul_ps(vx, _mm_set1_ps(1.05f)));
+		__m128 new_vy = clampVelocity(_mm_add_ps(vy, _mm_mul_ps(_mm_set1_ps(0.5f), paddle_velocity)));
+
+		vx = _mm_blendv_ps(vx, new_vx, hit);
+		vy = _mm_blendv_ps(vy, new_vy, hit);
+		cooldown = _mm_castps_si128(_mm_blendv_ps(_mm_castsi128_ps(cooldown), _mm_castsi128_ps(threshold), hit));
+
+		_mm_storeu_ps(&batch.ball_x[i], bx);
+		_mm_storeu_ps(&batch.ball_y[i], by);
+		_mm_storeu_ps(&batch.velocity_x[i], vx);
+		_mm_storeu_ps(&batch.velocity_y[i], vy);
+		_mm_storeu_si128((__m128i*)&batch.collision_cooldown[i], cooldown);
+	}
+
+	collidePaddlesScalar(batch, i, end);
+}
+
+TARGET_AVX2 static inline __m256 clampVelocity(__m256 v) {
+	const __m256 sign = _mm256_set1_ps(-0.0f);
+	const __m256 zero = _mm256_setzero_ps();
+	const __m256 min = _mm256_set1_ps(ball_min_velocity);
+	const __m256 max = _mm256_set1_ps(ball_max_velocity);
+
+	__m256 signed_min = _mm256_blendv_ps(_mm256_xor_ps(min, sign), min, _mm256_cmp_ps(v, zero, _CMP_GT_OQ));
+	v = _mm256_blendv_ps(v, signed_min, _mm256_cmp_ps(_mm256_andnot_ps(sign, v), min, _CMP_LT_OQ));
+
+	__m256 signed_max = _mm256_blendv_ps(_mm256_xor_ps(max, sign), max, _mm256_cmp_ps(v, zero, _CMP_GT_OQ));
+	return _mm256_blendv_ps(v, signed_max, _mm256_cmp_ps(_mm256_andnot_ps(sign, v), max, _CMP_GT_OQ));
+}
+
+TARGET_AVX2 static void collidePaddlesAVX2(MatchBatch& batch, std::size_t begin, std::size_t end) {
+	const __m256 sign = _mm256_set1_ps(-0.0f);
+	const __m256 zero = _mm256_setzero_ps();
+	const __m256 push_margin = _mm256_set1_ps(0.1f);
+	const __m256 left_x = _mm256_set1_ps(paddle_margin);
+	const __m256 right_x = _mm256_set1_ps(batch.width - paddle_margin);
+	const __m256 extent_x = _mm256_set1_ps(hit_extent_x);
+	const __m256 extent_y = _mm256_set1_ps(hit_extent_y);
+	const __m256i zero_i = _mm256_setzero_si256();
+	const __m256i threshold = _mm256_set1_epi32(collision_threshold);
+
+	std::size_t i = begin;
+
+	for (; i + 8 <= end; i += 8) {
+		__m256 bx = _mm256_loadu_ps(&batch.ball_x[i]);
+		__m256 by = _mm256_loadu_ps(&batch.ball_y[i]);
+		__m256 vx = _mm256_loadu_ps(&batch.velocity_x[i]);
+		__m256 vy = _mm256_loadu_ps(&batch.velocity_y[i]);
+		__m256 left_y = _mm256_loadu_ps(&batch.left_paddle_y[i]);
+		__m256 right_y = _mm256_loadu_ps(&batch.right_paddle_y[i]);
+		__m256i cooldown = _mm256_loadu_si256((const __m256i*)&batch.collision_cooldown[i]);
+
+		// Counts cooldown down, compare gives -1 where it is still positive
+		cooldown = _mm256_add_epi32(cooldown, _mm256_cmpgt_epi32(cooldown, zero_i));
+		__m256 ready = _mm256_castsi256_ps(_mm256_cmpeq_epi32(cooldown, zero_i));
+
+		__m256 left_dx = _mm256_sub_ps(_mm256_andnot_ps(sign, _mm256_sub_ps(bx, left_x)), extent_x);
+		__m256 left_dy = _mm256_sub_ps(_mm256_andnot_ps(sign, _mm256_sub_ps(by, left_y)), extent_y);
+		__m256 right_dx = _mm256_sub_ps(_mm256_andnot_ps(sign, _mm256_sub_ps(bx, right_x)), extent_x);
+		__m256 right_dy = _mm256_sub_ps(_mm256_andnot_ps(sign, _mm256_sub_ps(by, right_y)), extent_y);
+
+		// Left paddle wins ties, right is only checked where left missed
+		__m256 hit_left = _mm256_and_ps(ready, _mm256_and_ps(_mm256_cmp_ps(left_dx, zero, _CMP_LT_OQ), _mm256_cmp_ps(left_dy, zero, _CMP_LT_OQ)));
+		__m256 hit_right = _mm256_andnot_ps(hit_left, _mm256_and_ps(ready, _mm256_and_ps(_mm256_cmp_ps(right_dx, zero, _CMP_LT_OQ), _mm256_cmp_ps(right_dy, zero, _CMP_LT_OQ))));
+		__m256 hit = _mm256_or_ps(hit_left, hit_right);
+
+		if (_mm256_movemask_ps(hit) == 0) {
+			_mm256_storeu_si256((__m256i*)&batch.collision_cooldown[i], cooldown);
+			continue;
+		}
+
+		__m256 paddle_x = _mm256_blendv_ps(right_x, left_x, hit_left);
+		__m256 paddle_y = _mm256_blendv_ps(right_y, left_y, hit_left);
+		__m256 paddle_velocity = _mm256_blendv_ps(_mm256_loadu_ps(&batch.right_paddle_velocity[i]), _mm256_loadu_ps(&batch.left_paddle_velocity[i]), hit_left);
+		__m256 dx = _mm256_blendv_ps(right_dx, left_dx, hit_left);
+		__m256 dy = _mm256_blendv_ps(right_dy, left_dy, hit_left);
+
+		// Horizontal (left/right of paddle) or vertical (top/bottom) hit
+		__m256 horizontal = _mm256_and_ps(hit, _mm256_cmp_ps(dx, dy, _CMP_GT_OQ));
+		__m256 vertical = _mm256_andnot_ps(horizontal, hit);
+
+		__m256 push_x = _mm256_xor_ps(_mm256_add_ps(dx, push_margin), _mm256_and_ps(_mm256_cmp_ps(bx, paddle_x, _CMP_LT_OQ), sign));
+		__m256 push_y = _mm256_xor_ps(_mm256_add_ps(dy, push_margin), _mm256_and_ps(_mm256_cmp_ps(by, paddle_y, _CMP_LT_OQ), sign));
+
+		bx = _mm256_blendv_ps(bx, _mm256_add_ps(bx, push_x), horizontal);
+		by = _mm256_blendv_ps(by, _mm256_add_ps(by, push_y), vertical);
+		vx = _mm256_blendv_ps(vx, _mm256_xor_ps(vx, sign), horizontal);
+		vy = _mm256_blendv_ps(vy, _mm256_xor_ps(vy, sign), vertical);
+
+		// Speed up ball
+		__m256 new_vx = clampVelocity(_mm256_mul_ps(vx, _mm256_set1_ps(1.05f)));
+		__m256 new_vy = clampVelocity(_mm256_add_ps(vy, _mm256_mul_ps(_mm256_set1_ps(0.5f), paddle_velocity)));
+
+		vx = _mm256_blendv_ps(vx, new_vx, hit);
+		vy = _mm256_blendv_ps(vy, new_vy, hit);
+		cooldown = _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(cooldown), _mm256_castsi256_ps(threshold), hit));
+
+		_mm256_storeu_ps(&batch.ball_x[i], bx);
+		_mm256_storeu_ps(&batch.ball_y[i], by);
+		_mm256_storeu_ps(&batch.velocity_x[i], vx);
+		_mm256_storeu_ps(&batch.velocity_y[i], vy);
+		_mm256_storeu_si256((__m256i*)&batch.collision_cooldown[i], cooldown);
+	}
+
+	collidePaddlesScalar(batch, i, end);
+}
+
+#endif
+
+void collidePaddles(MatchBatch& batch, std::size_t begin, std::size_t end, SimdLevel level) {
+#ifdef COLLISION_KERNELS_X86
+	switch (level) {
+		case SIMD_AVX2:
+			collidePaddlesAVX2(batch, begin, end);
+			return;
+		case SIMD_SSE41:
+			collidePaddlesSSE41(batch, begin, end);
+			return;
+		default:
+			break;
+	}
+#endif
+	collidePaddlesScalar(batch, begin, end);
+}
+
+template <typename T>
+static bool sameBits(const std::vector<T>& a, const std::vector<T>& b) {
+	return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(T)) == 0;
+}
+
+bool collisionKernelsMatch(SimdLevel level, std::size_t samples, unsigned int seed) {
+	MatchBatch reference(samples, 800, 600);
+	std::mt19937 rng(seed);
+
+	std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+	std::uniform_real_distribution<float> velocity(-2.0f * ball_max_velocity, 2.0f * ball_max_velocity);
+	std::uniform_int_distribution<int> pick(0, 7);
+
+	// Velocities right on the clamp edges, including both zeros
+	const float edges[] = { 0.0f, -0.0f, ball_min_velocity, -ball_min_velocity, ball_max_velocity, -ball_max_velocity, 19.99f, 300.01f };
+	const float paddle_velocities[] = { -paddle_speed, 0.0f, paddle_speed };
+
+	for (std::size_t i = 0; i < samples; i++) {
+		reference.left_paddle_y[i] = paddle_boundary + unit(rng) * (reference.height - 2 * paddle_boundary);
+		reference.right_paddle_y[i] = paddle_boundary + unit(rng) * (reference.height - 2 * paddle_boundary);
+		reference.left_paddle_velocity[i] = paddle_velocities[pick(rng) % 3];
+		reference.right_paddle_velocity[i] = paddle_velocities[pick(rng) % 3];
+
+		// Most balls are placed around a paddle so every branch gets hit
+		bool near_left = pick(rng) < 4;
+		float paddle_x = near_left ? paddle_margin : reference.width - paddle_margin;
+		float paddle_y = near_left ? reference.left_paddle_y[i] : reference.right_paddle_y[i];
+
+		reference.ball_x[i] = paddle_x + (unit(rng) - 0.5f) * 4.0f * hit_extent_x;
+		reference.ball_y[i] = paddle_y + (unit(rng) - 0.5f) * 3.0f * hit_extent_y;
+
+		reference.velocity_x[i] = pick(rng) == 0 ? edges[pick(rng)] : velocity(rng);
+		reference.velocity_y[i] = pick(rng) == 0 ? edges[pick(rng)] : velocity(rng);
+
+		reference.collision_cooldown[i] = pick(rng) % (collision_threshold + 1);
+	}
+
+	MatchBatch candidate = reference;
+
+	// Odd bounds so both the vector body and the scalar tail are covered
+	std::size_t begin = samples > 1 ? 1 : 0;
+
+	collidePaddlesScalar(reference, begin, samples);
+	collidePaddles(candidate, begin, samples, level);
+
+	return sameBits(reference.ball_x, candidate.ball_x) && sameBits(reference.ball_y, candidate.ball_y)
+		&& sameBits(reference.velocity_x, candidate.velocity_x) && sameBits(reference.velocity_y, candidate.velocity_y)
+		&& sameBits(reference.collision_cooldown, candidate.collision_cooldown);
+}
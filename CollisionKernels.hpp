@@ -0,0 +1,17 @@
+#pragma once
+
+#include <cstddef>
+
+#include "Simd.hpp"
+
+class MatchBatch;
+
+// Paddle collision pass for matches in [begin, end): cooldown, hit side selection,
+// push out, speed up and velocity clamp. Every level gives bit-identical results
+void collidePaddles(MatchBatch& batch, std::size_t begin, std::size_t end, SimdLevel level);
+
+// Reference implementation, mirrors Game::Update branch by branch
+void collidePaddlesScalar(MatchBatch& batch, std::size_t begin, std::size_t end);
+
+// Runs random states through the scalar and the given level and compares them bit by bit
+bool collisionKernelsMatch(SimdLevel level, std::size_t samples, unsigned int seed);
@@ -0,0 +1,161 @@
+#include "DeterministicMatch.hpp"
+
+#include "Game.hpp"
+#include "Random.hpp"
+
+// Game's float constants, written as exact ratios
+static const Fixed fixed_dt = Fixed::fromRatio(1, DeterministicMatch::ticks_per_second);
+static const Fixed fixed_ball_radius = Fixed::fromRatio(14, 2);
+static const Fixed fixed_paddle_margin = Fixed::fromInt(35);
+static const Fixed fixed_paddle_speed = Fixed::fromInt(150);
+static const Fixed fixed_paddle_boundary = Fixed::fromRatio(80 + 14, 2);
+static const Fixed fixed_extent_x = Fixed::fromRatio(12, 2) + fixed_ball_radius;
+static const Fixed fixed_extent_y = Fixed::fromRatio(80, 2) + fixed_ball_radius;
+static const Fixed fixed_min_velocity = Fixed::fromInt(20);
+static const Fixed fixed_max_velocity = Fixed::fromInt(300);
+static const Fixed fixed_speed_up = Fixed::fromRatio(105, 100);
+static const Fixed fixed_half = Fixed::fromRatio(1, 2);
+static const Fixed fixed_push = Fixed::fromRatio(1, 10);
+
+// SplitMix64 finalizer, mixes each word into the hash
+static uint64_t mix64(uint64_t x) {
+	x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+	x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+	return x ^ (x >> 31);
+}
+
+static uint64_t hashCombine(uint64_t hash, uint64_t value) {
+	return mix64(hash ^ (value + 0x9E3779B97F4A7C15ull + (hash << 6) + (hash >> 2)));
+}
+
+// Checks for ball minimum and maximum velocities
+static Fixed clampVelocity(Fixed v) {
+	if (abs(v) < fixed_min_velocity) v = (v > Fixed::fromInt(0)) ? fixed_min_velocity : -fixed_min_velocity;
+	if (abs(v) > fixed_max_velocity) v = (v > Fixed::fromInt(0)) ? fixed_max_velocity : -fixed_max_velocity;
+	return v;
+}
+
+DeterministicMatch::DeterministicMatch(uint64_t seed, int32_t width, int32_t height, uint64_t match)
+	: width(width), height(height), collision_cooldown(0), tick(0), seed(seed), match(match) {
+	score[0] = 0;
+	score[1] = 0;
+
+	paddle_y[0] = Fixed::fromRatio(height, 2);
+	paddle_y[1] = Fixed::fromRatio(height, 2);
+	paddle_velocity[0] = Fixed::fromInt(0);
+	paddle_velocity[1] = Fixed::fromInt(0);
+
+	serve(0);
+
+	hash = StateHash();
+}
+
+uint64_t DeterministicMatch::Step(int8_t left_input, int8_t right_input) {
+	const Fixed w = Fixed::fromInt(width);
+	const Fixed h = Fixed::fromInt(height);
+	const Fixed zero = Fixed::fromInt(0);
+	const Fixed paddle_x[2] = { fixed_paddle_margin, w - fixed_paddle_margin };
+	const int8_t input[2] = { left_input, right_input };
+
+	// Paddle input, same rules as Game::ProcessInput
+	for (int lr = 0; lr < 2; lr++) {
+		paddle_velocity[lr] = zero;
+
+		if (input[lr] > 0) {
+			if (paddle_y[lr] < h - fixed_paddle_boundary) paddle_velocity[lr] = fixed_paddle_speed;
+			else paddle_y[lr] = h - fixed_paddle_boundary;
+		}
+		else if (input[lr] < 0) {
+			if (paddle_y[lr] > fixed_paddle_boundary) paddle_velocity[lr] = -fixed_paddle_speed;
+			else paddle_y[lr] = fixed_paddle_boundary;
+		}
+	}
+
+	// Collision with top or bottom wall
+	if (ball_y - fixed_ball_radius <= zero || ball_y + fixed_ball_radius >= h) {
+		velocity_y = -velocity_y;
+		ball_y += (ball_y > h / Fixed::fromInt(2)) ? -fixed_push : fixed_push;
+	}
+
+	// Collision with left or right wall
+	if (ball_x - fixed_ball_radius <= zero) {
+		score[1]++;
+		serve(1);
+	}
+	else if (ball_x + fixed_ball_radius >= w) {
+		score[0]++;
+		serve(-1);
+	}
+
+	// Paddle collision, same per tick rules and cooldown as MatchBatch
+	if (collision_cooldown > 0) {
+		collision_cooldown--;
+	}
+
+	if (collision_cooldown == 0) {
+		for (int lr = 0; lr < 2; lr++) {
+			Fixed distance_x = abs(ball_x - paddle_x[lr]) - fixed_extent_x;
+			Fixed distance_y = abs(ball_y - paddle_y[lr]) - fixed_extent_y;
+
+			if (distance_x < zero && distance_y < zero) {
+				if (distance_x > distance_y) {
+					velocity_x = -velocity_x;
+					Fixed push = distance_x + fixed_push;
+					ball_x += (ball_x < paddle_x[lr]) ? -push : push;
+				}
+				else {
+					velocity_y = -velocity_y;
+					Fixed push = distance_y + fixed_push;
+					ball_y += (ball_y < paddle_y[lr]) ? -push : push;
+				}
+
+				// Speed up ball
+				velocity_x = clampVelocity(velocity_x * fixed_speed_up);
+				velocity_y = clampVelocity(velocity_y + fixed_half * paddle_velocity[lr]);
+
+				collision_cooldown = collision_threshold;
+				break;
+			}
+		}
+	}
+
+	// Updates paddles and ball positions
+	paddle_y[0] += paddle_velocity[0] * fixed_dt;
+	paddle_y[1] += paddle_velocity[1] * fixed_dt;
+
+	ball_x += velocity_x * fixed_dt;
+	ball_y += velocity_y * fixed_dt;
+
+	tick++;
+	hash = StateHash();
+	return hash;
+}
+
+uint64_t DeterministicMatch::StateHash() const {
+	// Fields are folded in a fixed order, two 32 bit values per word
+	uint64_t h = 0x8F1BBCDCCA62C1D6ull;
+
+	h = hashCombine(h, tick);
+	h = hashCombine(h, seed);
+	h = hashCombine(h, match);
+	h = hashCombine(h, ((uint64_t)(uint32_t)ball_x.raw << 32) | (uint32_t)ball_y.raw);
+	h = hashCombine(h, ((uint64_t)(uint32_t)velocity_x.raw << 32) | (uint32_t)velocity_y.raw);
+	h = hashCombine(h, ((uint64_t)(uint32_t)paddle_y[0].raw << 32) | (uint32_t)paddle_y[1].raw);
+	h = hashCombine(h, ((uint64_t)(uint32_t)paddle_velocity[0].raw << 32) | (uint32_t)paddle_velocity[1].raw);
+	h = hashCombine(h, ((uint64_t)score[0] << 32) | score[1]);
+	h = hashCombine(h, ((uint64_t)(uint32_t)width << 32) | (uint32_t)height);
+	h = hashCombine(h, (uint64_t)(uint32_t)collision_cooldown);
+
+	return h;
+}
+
+// Centers ball and draws the next serve's velocity
+void DeterministicMatch::serve(int direction) {
+	ServeVelocity velocity = serveVelocity(seed, match, score[0] + score[1], direction);
+
+	velocity_x = Fixed::fromInt(velocity.x);
+	velocity_y = Fixed::fromInt(velocity.y);
+
+	ball_x = Fixed::fromRatio(width, 2);
+	ball_y = Fixed::fromRatio(height, 2);
+}
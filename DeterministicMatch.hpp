@@ -0,0 +1,44 @@
+#pragma once
+
+#include <cstdint>
+
+#include "FixedPoint.hpp"
+
+// Lockstep/replay mode, a match in Q16.16 fixed point stepped at a fixed tick with
+// counter based serves. Two matches with the same seed and inputs hash the same every tick
+class DeterministicMatch {
+	public:
+		static const int ticks_per_second = 120;
+
+		int32_t width, height;
+
+		Fixed ball_x, ball_y;
+		Fixed velocity_x, velocity_y;
+
+		Fixed paddle_y[2];
+		Fixed paddle_velocity[2];
+
+		int32_t collision_cooldown;
+		uint32_t score[2];
+
+		uint64_t tick;
+
+		// Serves are drawn from (seed, match, serves so far)
+		uint64_t seed;
+		uint64_t match;
+
+		// Hash of the full state after the last tick
+		uint64_t hash;
+
+		DeterministicMatch(uint64_t seed, int32_t width, int32_t height, uint64_t match = 0);
+
+		// Advances one fixed tick, inputs are -1 (down), 0 (idle) or 1 (up) per paddle,
+		// and returns the new state hash
+		uint64_t Step(int8_t left_input, int8_t right_input);
+
+		uint64_t StateHash() const;
+
+	private:
+		// Direction of the serve's x velocity, -1 or 1, random when 0
+		void serve(int direction);
+};
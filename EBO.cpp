@@ -1,19 +1,21 @@
 #include "EBO.hpp"
 
-EBO::EBO(GLuint* indices, GLsizeiptr size) {
-	glGenBuffers(1, &ID);
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ID);
-	glBufferData(GL_ELEMENT_ARRAY_BUFFER, size, indices, GL_STATIC_DRAW);
+#include "GLState.hpp"
+
+EBO::EBO(const GLuint* indices, GLsizeiptr size) {
+	glCreateBuffers(1, &ID);
+	glNamedBufferData(ID, size, indices, GL_STATIC_DRAW);
 }
 
 void EBO::Bind() {
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ID);
+	GLState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, ID);
 }
 
 void EBO::Unbind() {
-	glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+	GLState::BindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
 }
 
 void EBO::Delete() {
+	GLState::ForgetBuffer(ID);
 	glDeleteBuffers(1, &ID);
 }
\ No newline at end of file
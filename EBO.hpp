@@ -5,7 +5,7 @@
 class EBO {
 public:
 	GLuint ID;
-	EBO(GLuint* indices, GLsizeiptr size);
+	EBO(const GLuint* indices, GLsizeiptr size);
 
 	void Bind();
 	void Unbind();
@@ -0,0 +1,62 @@
+#include "EventSimulation.hpp"
+
+// Safety net against zero time event loops inside a single Advance
+const unsigned int max_events_per_advance = 100000;
+
+EventSimulation::EventSimulation(Game& game) : game(game), time(0.0), events(0) {
+	Replan();
+}
+
+void EventSimulation::Replan() {
+	game.ProcessInput();
+	next = game.NextContact();
+}
+
+void EventSimulation::Advance(float duration) {
+	float remaining = duration;
+
+	for (unsigned int i = 0; i < max_events_per_advance && next.time <= remaining; i++) {
+		remaining -= next.time;
+		move(next.time);
+		resolve();
+	}
+
+	move(remaining);
+}
+
+float EventSimulation::AdvanceToNextEvent(float max_duration) {
+	if (next.time > max_duration) {
+		move(max_duration);
+		return max_duration;
+	}
+
+	float advanced = next.time;
+
+	move(advanced);
+	resolve();
+
+	return advanced;
+}
+
+SimulationEvent EventSimulation::NextEvent() const {
+	return next.event;
+}
+
+float EventSimulation::TimeToNextEvent() const {
+	return next.time;
+}
+
+void EventSimulation::move(float dt) {
+	game.Move(dt);
+	next.time -= dt;
+	time += dt;
+}
+
+void EventSimulation::resolve() {
+	if (next.event != EVENT_NONE) {
+		game.Resolve(next);
+		events++;
+	}
+
+	next = game.NextContact();
+}
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "Game.hpp"
+
+// Analytic simulation mode, between events everything moves in straight lines so the
+// time to the next wall, goal, paddle hit or paddle stop is solved in closed form and
+// the game jumps straight to it instead of integrating every frame
+class EventSimulation {
+	public:
+		Game& game;
+
+		// Simulated seconds and events processed since construction
+		double time;
+		unsigned long long events;
+
+		EventSimulation(Game& game);
+
+		// Must be called whenever game.keys change, applies them and plans the next event
+		void Replan();
+
+		// Advances exactly duration seconds, resolving every event on the way
+		void Advance(float duration);
+		// Advances to the next event (or at most max_duration) and returns the time advanced
+		float AdvanceToNextEvent(float max_duration);
+
+		SimulationEvent NextEvent() const;
+		float TimeToNextEvent() const;
+
+	private:
+		// Cached until it fires or the input changes
+		Contact next;
+
+		void move(float dt);
+		void resolve();
+};
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+
+// Q16.16 fixed point number, every operation is plain integer math so results are
+// identical on every compiler, CPU and optimization level
+struct Fixed {
+	static const int fraction_bits = 16;
+	static const int32_t one = 1 << fraction_bits;
+
+	int32_t raw;
+
+	static Fixed fromRaw(int32_t raw) { Fixed f; f.raw = raw; return f; }
+	static Fixed fromInt(int value) { return fromRaw((int32_t)(value * one)); }
+	// numerator / denominator rounded towards zero, keeps constants free of float parsing
+	static Fixed fromRatio(int numerator, int denominator) { return fromRaw((int32_t)((int64_t)numerator * one / denominator)); }
+
+	// Only for rendering and logging, never fed back into the simulation
+	float toFloat() const { return raw / (float)one; }
+
+	Fixed operator-() const { return fromRaw(-raw); }
+	Fixed operator+(Fixed other) const { return fromRaw(raw + other.raw); }
+	Fixed operator-(Fixed other) const { return fromRaw(raw - other.raw); }
+	Fixed operator*(Fixed other) const { return fromRaw((int32_t)(((int64_t)raw * other.raw) >> fraction_bits)); }
+	Fixed operator/(Fixed other) const { return fromRaw((int32_t)((int64_t)raw * one / other.raw)); }
+
+	Fixed& operator+=(Fixed other) { raw += other.raw; return *this; }
+	Fixed& operator-=(Fixed other) { raw -= other.raw; return *this; }
+	Fixed& operator*=(Fixed other) { *this = *this * other; return *this; }
+
+	bool operator==(Fixed other) const { return raw == other.raw; }
+	bool operator!=(Fixed other) const { return raw != other.raw; }
+	bool operator<(Fixed other) const { return raw < other.raw; }
+	bool operator<=(Fixed other) const { return raw <= other.raw; }
+	bool operator>(Fixed other) const { return raw > other.raw; }
+	bool operator>=(Fixed other) const { return raw >= other.raw; }
+};
+
+inline Fixed abs(Fixed value) {
+	return value.raw < 0 ? -value : value;
+}
@@ -0,0 +1,43 @@
+#include "FixedTimestep.hpp"
+
+#include <chrono>
+
+uint64_t monotonicNanoseconds() {
+	return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+FixedTimestep::FixedTimestep(uint64_t tick_ns, unsigned int max_ticks_per_frame)
+	: tick_ns(tick_ns), accumulator_ns(0), last_ns(0), max_ticks_per_frame(max_ticks_per_frame) {
+	Start();
+}
+
+void FixedTimestep::Start() {
+	accumulator_ns = 0;
+	last_ns = monotonicNanoseconds();
+}
+
+unsigned int FixedTimestep::Advance() {
+	uint64_t now = monotonicNanoseconds();
+	accumulator_ns += now - last_ns;
+	last_ns = now;
+
+	uint64_t ticks = accumulator_ns / tick_ns;
+
+	// Drops the time we can't catch up on, the game slows down instead of freezing
+	if (ticks > max_ticks_per_frame) {
+		ticks = max_ticks_per_frame;
+		accumulator_ns = ticks * tick_ns;
+	}
+
+	accumulator_ns -= ticks * tick_ns;
+	return (unsigned int)ticks;
+}
+
+float FixedTimestep::TickSeconds() const {
+	return (float)(tick_ns / 1e9);
+}
+
+float FixedTimestep::Alpha() const {
+	return (float)((double)accumulator_ns / (double)tick_ns);
+}
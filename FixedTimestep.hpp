@@ -0,0 +1,32 @@
+#pragma once
+
+#include <cstdint>
+
+// Nanoseconds from a monotonic clock, kept as an integer so it doesn't lose precision
+// after long uptimes the way a float of seconds does
+uint64_t monotonicNanoseconds();
+
+// Accumulates real time and hands it out as whole simulation ticks, so physics runs at
+// the same rate whatever the display refresh rate is
+class FixedTimestep {
+	public:
+		uint64_t tick_ns;
+		uint64_t accumulator_ns;
+		uint64_t last_ns;
+
+		// Caps catch up after a stall (window drag, breakpoint) instead of spiraling
+		unsigned int max_ticks_per_frame;
+
+		FixedTimestep(uint64_t tick_ns, unsigned int max_ticks_per_frame = 8);
+
+		// Restarts the clock with an empty accumulator
+		void Start();
+
+		// Adds the time since the last call and returns how many ticks to simulate
+		unsigned int Advance();
+
+		float TickSeconds() const;
+
+		// How far into the next tick the accumulator is, 0 to 1, for render interpolation
+		float Alpha() const;
+};
@@ -0,0 +1,264 @@
+#include "GLState.hpp"
+
+// Binding value the cache doesn't know, the next call always goes through
+const GLuint unknown_binding = 0xFFFFFFFF;
+
+// Buffer targets the renderer uses, anything else is passed straight through
+const GLenum buffer_targets[] = {
+	GL_ARRAY_BUFFER,
+	GL_ELEMENT_ARRAY_BUFFER,
+	GL_DRAW_INDIRECT_BUFFER,
+	GL_UNIFORM_BUFFER,
+	GL_SHADER_STORAGE_BUFFER,
+	GL_PIXEL_PACK_BUFFER,
+	GL_PIXEL_UNPACK_BUFFER,
+	GL_COPY_READ_BUFFER,
+	GL_COPY_WRITE_BUFFER
+};
+const unsigned int buffer_target_count = sizeof(buffer_targets) / sizeof(buffer_targets[0]);
+
+const GLenum texture_targets[] = {
+	GL_TEXTURE_2D,
+	GL_TEXTURE_2D_ARRAY
+};
+const unsigned int texture_target_count = sizeof(texture_targets) / sizeof(texture_targets[0]);
+
+// Indexed targets the renderer binds ranges on, by binding point
+const GLenum indexed_targets[] = {
+	GL_UNIFORM_BUFFER,
+	GL_SHADER_STORAGE_BUFFER
+};
+const unsigned int indexed_target_count = sizeof(indexed_targets) / sizeof(indexed_targets[0]);
+
+// Guaranteed minimum of both uniform and storage binding points is 8
+const unsigned int indexed_binding_count = 8;
+
+struct IndexedBinding {
+	GLuint buffer;
+	GLintptr offset;
+	GLsizeiptr size;
+};
+
+// Guaranteed minimum of combined texture units in 4.6 core is 80, the renderer uses far fewer
+const unsigned int texture_unit_count = 32;
+
+static GLuint program = unknown_binding;
+static GLuint vertex_array = unknown_binding;
+static GLuint buffers[buffer_target_count];
+static IndexedBinding indexed[indexed_target_count][indexed_binding_count];
+static GLuint active_texture = unknown_binding;
+static GLuint textures[texture_unit_count][texture_target_count];
+static GLuint draw_framebuffer = unknown_binding;
+static GLuint read_framebuffer = unknown_binding;
+
+static GLState::Counters counters = { 0, 0 };
+static bool initialized = false;
+
+static int bufferSlot(GLenum target) {
+	for (unsigned int i = 0; i < buffer_target_count; i++) {
+		if (buffer_targets[i] == target) return (int)i;
+	}
+	return -1;
+}
+
+static int indexedSlot(GLenum target) {
+	for (unsigned int i = 0; i < indexed_target_count; i++) {
+		if (indexed_targets[i] == target) return (int)i;
+	}
+	return -1;
+}
+
+static int textureSlot(GLenum target) {
+	for (unsigned int i = 0; i < texture_target_count; i++) {
+		if (texture_targets[i] == target) return (int)i;
+	}
+	return -1;
+}
+
+// True when the call has to reach GL, updates the mirror and counters either way
+static bool changes(GLuint& cached, GLuint value) {
+	if (!initialized) {
+		GLState::Invalidate();
+	}
+
+	if (cached == value) {
+		counters.avoided++;
+		return false;
+	}
+
+	cached = value;
+	counters.issued++;
+	return true;
+}
+
+void GLState::UseProgram(GLuint program_id) {
+	if (changes(program, program_id)) {
+		glUseProgram(program_id);
+	}
+}
+
+void GLState::BindVertexArray(GLuint vertex_array_id) {
+	if (changes(vertex_array, vertex_array_id)) {
+		glBindVertexArray(vertex_array_id);
+
+		// The element buffer binding belongs to the VAO
+		buffers[bufferSlot(GL_ELEMENT_ARRAY_BUFFER)] = unknown_binding;
+	}
+}
+
+void GLState::BindBuffer(GLenum target, GLuint buffer) {
+	int slot = bufferSlot(target);
+
+	if (slot < 0) {
+		counters.issued++;
+		glBindBuffer(target, buffer);
+	}
+	else if (changes(buffers[slot], buffer)) {
+		glBindBuffer(target, buffer);
+	}
+}
+
+void GLState::BindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size) {
+	if (!initialized) {
+		Invalidate();
+	}
+
+	int slot = bufferSlot(target);
+	int indexed_slot = indexedSlot(target);
+
+	if (indexed_slot < 0 || index >= indexed_binding_count) {
+		counters.issued++;
+		glBindBufferRange(target, index, buffer, offset, size);
+
+		if (slot >= 0) buffers[slot] = buffer;
+		return;
+	}
+
+	IndexedBinding& binding = indexed[indexed_slot][index];
+
+	// Same range but a different generic binding still has to go through to move the generic one
+	if (binding.buffer == buffer && binding.offset == offset && binding.size == size && buffers[slot] == buffer) {
+		counters.avoided++;
+		return;
+	}
+
+	binding.buffer = buffer;
+	binding.offset = offset;
+	binding.size = size;
+	buffers[slot] = buffer;
+	counters.issued++;
+	glBindBufferRange(target, index, buffer, offset, size);
+}
+
+void GLState::BindFramebuffer(GLenum target, GLuint framebuffer) {
+	if (target == GL_DRAW_FRAMEBUFFER) {
+		if (changes(draw_framebuffer, framebuffer)) {
+			glBindFramebuffer(target, framebuffer);
+		}
+	}
+	else if (target == GL_READ_FRAMEBUFFER) {
+		if (changes(read_framebuffer, framebuffer)) {
+			glBindFramebuffer(target, framebuffer);
+		}
+	}
+	else {
+		if (!initialized) {
+			Invalidate();
+		}
+
+		if (draw_framebuffer == framebuffer && read_framebuffer == framebuffer) {
+			counters.avoided++;
+			return;
+		}
+
+		draw_framebuffer = framebuffer;
+		read_framebuffer = framebuffer;
+		counters.issued++;
+		glBindFramebuffer(target, framebuffer);
+	}
+}
+
+void GLState::ActiveTexture(GLenum unit) {
+	if (changes(active_texture, unit)) {
+		glActiveTexture(unit);
+	}
+}
+
+void GLState::BindTexture(GLenum target, GLuint texture) {
+	int slot = textureSlot(target);
+	unsigned int unit = active_texture == unknown_binding ? texture_unit_count : active_texture - GL_TEXTURE0;
+
+	if (slot < 0 || unit >= texture_unit_count) {
+		counters.issued++;
+		glBindTexture(target, texture);
+	}
+	else if (changes(textures[unit][slot], texture)) {
+		glBindTexture(target, texture);
+	}
+}
+
+void GLState::ForgetProgram(GLuint program_id) {
+	if (program == program_id) program = unknown_binding;
+}
+
+void GLState::ForgetVertexArray(GLuint vertex_array_id) {
+	if (vertex_array == vertex_array_id) vertex_array = unknown_binding;
+}
+
+void GLState::ForgetBuffer(GLuint buffer) {
+	for (unsigned int i = 0; i < buffer_target_count; i++) {
+		if (buffers[i] == buffer) buffers[i] = unknown_binding;
+	}
+
+	for (unsigned int i = 0; i < indexed_target_count; i++) {
+		for (unsigned int index = 0; index < indexed_binding_count; index++) {
+			if (indexed[i][index].buffer == buffer) indexed[i][index].buffer = unknown_binding;
+		}
+	}
+}
+
+void GLState::ForgetTexture(GLuint texture) {
+	for (unsigned int unit = 0; unit < texture_unit_count; unit++) {
+		for (unsigned int i = 0; i < texture_target_count; i++) {
+			if (textures[unit][i] == texture) textures[unit][i] = unknown_binding;
+		}
+	}
+}
+
+void GLState::ForgetFramebuffer(GLuint framebuffer) {
+	if (draw_framebuffer == framebuffer) draw_framebuffer = unknown_binding;
+	if (read_framebuffer == framebuffer) read_framebuffer = unknown_binding;
+}
+
+void GLState::Invalidate() {
+	program = unknown_binding;
+	vertex_array = unknown_binding;
+	active_texture = unknown_binding;
+	draw_framebuffer = unknown_binding;
+	read_framebuffer = unknown_binding;
+
+	for (unsigned int i = 0; i < buffer_target_count; i++) {
+		buffers[i] = unknown_binding;
+	}
+
+	for (unsigned int i = 0; i < indexed_target_count; i++) {
+		for (unsigned int index = 0; index < indexed_binding_count; index++) {
+			indexed[i][index].buffer = unknown_binding;
+		}
+	}
+
+	for (unsigned int unit = 0; unit < texture_unit_count; unit++) {
+		for (unsigned int i = 0; i < texture_target_count; i++) {
+			textures[unit][i] = unknown_binding;
+		}
+	}
+
+	initialized = true;
+}
+
+GLState::Counters GLState::Frame() {
+	Counters frame = counters;
+	counters.issued = 0;
+	counters.avoided = 0;
+	return frame;
+}
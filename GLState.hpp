@@ -0,0 +1,38 @@
+#pragma once
+
+#include <glad/glad.h>
+
+// Mirrors the GL bindings the renderer touches and drops calls that would set a binding
+// to what it already is. Every Bind/Activate goes through here so the mirror stays right
+class GLState {
+	public:
+		// GL calls sent to the driver and calls dropped since the last Frame()
+		struct Counters {
+			unsigned long long issued;
+			unsigned long long avoided;
+		};
+
+		static void UseProgram(GLuint program);
+		static void BindVertexArray(GLuint vertex_array);
+		static void BindBuffer(GLenum target, GLuint buffer);
+		// Binds an indexed range, which also sets the target's generic binding
+		static void BindBufferRange(GLenum target, GLuint index, GLuint buffer, GLintptr offset, GLsizeiptr size);
+		// GL_FRAMEBUFFER sets both the draw and the read binding
+		static void BindFramebuffer(GLenum target, GLuint framebuffer);
+		static void ActiveTexture(GLenum unit);
+		// Binds on the active texture unit
+		static void BindTexture(GLenum target, GLuint texture);
+
+		// Deleted objects are unbound by GL, a later object may reuse the name
+		static void ForgetProgram(GLuint program);
+		static void ForgetVertexArray(GLuint vertex_array);
+		static void ForgetBuffer(GLuint buffer);
+		static void ForgetTexture(GLuint texture);
+		static void ForgetFramebuffer(GLuint framebuffer);
+
+		// For code that changed bindings behind the cache's back
+		static void Invalidate();
+
+		// Returns this frame's counters and starts the next frame
+		static Counters Frame();
+};
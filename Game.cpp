@@ -1,7 +1,12 @@
 #include "Game.hpp"
 
-Game::Game(unsigned int width, unsigned int height) {
+#include <algorithm>
+#include <cmath>
+#include <limits>
 
+Game::Game(unsigned int width, unsigned int height, uint64_t seed, uint64_t match)
+	: state(GAME_MENU), width(width), height(height), seed(seed), match(match) {
+	Init();
 }
 
 Game::~Game() {
@@ -9,17 +14,305 @@ Game::~Game() {
 }
 
 void Game::Init() {
+	for (int i = 0; i < KEY_COUNT; i++) {
+		keys[i] = false;
+	}
 
+	paddle_offsets[0] = { paddle_margin, height / 2.0f };
+	paddle_offsets[1] = { width - paddle_margin, height / 2.0f };
+
+	paddle_velocity[0] = 0.0f;
+	paddle_velocity[1] = 0.0f;
+
+	ball_offset = { width / 2.0f, height / 2.0f };
+
+	// First serve goes either way
+	ServeVelocity velocity = serveVelocity(seed, match, 0);
+	ball_velocity = { velocity.x, velocity.y };
+
+	winner = 0;
+	score[0] = 0;
+	score[1] = 0;
+	rallies = 0;
+
+	state = GAME_ACTIVE;
 }
 
-void Game::ProcessInput(float dt) {
+void Game::Resize(unsigned int width, unsigned int height) {
+	this->width = width;
+	this->height = height;
 
+	// Update paddle position
+	paddle_offsets[1].x = width - paddle_margin;
+}
+
+void Game::ProcessInput() {
+	paddle_velocity[0] = 0.0f;
+	paddle_velocity[1] = 0.0f;
+
+	// Left (0) and right (1) paddles
+	for (int lr = 0; lr < 2; lr++) {
+		if (keys[lr == 0 ? KEY_LEFT_UP : KEY_RIGHT_UP]) {
+			if (paddle_offsets[lr].y < height - paddle_boundary) {
+				paddle_velocity[lr] = paddle_speed;
+			}
+			else {
+				paddle_offsets[lr].y = height - paddle_boundary;
+			}
+		}
+
+		if (keys[lr == 0 ? KEY_LEFT_DOWN : KEY_RIGHT_DOWN]) {
+			if (paddle_offsets[lr].y > paddle_boundary) {
+				paddle_velocity[lr] = -paddle_speed;
+			}
+			else {
+				paddle_offsets[lr].y = paddle_boundary;
+			}
+		}
+	}
 }
 
 void Game::Update(float dt) {
+	if (state != GAME_ACTIVE) {
+		return;
+	}
+
+	// Paddles clamped by ProcessInput or a resize may have jumped onto the ball
+	Separate();
+
+	float remaining = dt;
+
+	for (unsigned int i = 0; i < max_contacts_per_update; i++) {
+		Contact contact = NextContact();
+
+		if (contact.time > remaining) {
+			Move(remaining);
+
+			// A pinned ball slides while squeezed, it may end the step inside the paddle
+			Separate();
+			return;
+		}
+
+		Move(contact.time);
+		remaining -= contact.time;
+
+		Resolve(contact);
+	}
+
+	// Too many contacts in one step (e.g. a ball wedged in a corner). Dropping the rest
+	// would freeze a wedge that repeats every step, so it moves on unchecked and anything
+	// that ended up inside a paddle is pushed back out
+	Move(remaining);
+	Separate();
+}
+
+Contact Game::NextContact() const {
+	Contact next = { EVENT_NONE, std::numeric_limits<float>::infinity(), 0, false, false };
+
+	// Paddles, the ball against each paddle's box while it moves
+	for (int lr = 0; lr < 2; lr++) {
+		float relative_y = ball_offset.y - paddle_offsets[lr].y;
+
+		// A ball pinned between the paddle's top/bottom and the wall has nowhere to
+		// bounce, it is left to slide out sideways. Only if the gap is too narrow for it,
+		// otherwise it bounces between the two like anywhere else
+		float gap = relative_y > 0 ? height - (paddle_offsets[lr].y + paddle_height / 2) : paddle_offsets[lr].y - paddle_height / 2;
+		bool touching = relative_y > 0 ? ball_offset.y + ball_radius >= height - squeeze_tolerance : ball_offset.y - ball_radius <= squeeze_tolerance;
+		bool pinned = gap < ball_diameter + squeeze_tolerance && touching;
+
+		if (pinned && std::abs(ball_offset.x - paddle_offsets[lr].x) < paddle_width / 2 + ball_radius) {
+			continue;
+		}
+
+		float time;
+		bool horizontal;
+
+		if (sweptCircleBox(ball_offset, ball_velocity, ball_radius,
+			paddle_offsets[lr], glm::vec2(paddle_width, paddle_height) / 2.0f, paddle_velocity[lr],
+			time, horizontal) && time < next.time) {
+			next.event = EVENT_PADDLE;
+			next.time = time;
+			next.paddle = lr;
+			next.horizontal = horizontal;
+		}
+	}
+
+	// Top or bottom wall
+	float wall = sweptBounds(ball_offset.y, ball_velocity.y, ball_radius, height - ball_radius);
+	if (wall < next.time) {
+		next.event = EVENT_WALL;
+		next.time = wall;
+	}
+
+	// Left or right wall
+	float goal = sweptBounds(ball_offset.x, ball_velocity.x, ball_radius, width - ball_radius);
+	if (goal < next.time) {
+		next.event = EVENT_GOAL;
+		next.time = goal;
+		next.winner = ball_velocity.x > 0;
+	}
+
+	// Paddles reaching the top or bottom boundary
+	for (int lr = 0; lr < 2; lr++) {
+		float stop = sweptBounds(paddle_offsets[lr].y, paddle_velocity[lr], paddle_boundary, height - paddle_boundary);
+
+		if (stop < next.time) {
+			next.event = EVENT_PADDLE_STOP;
+			next.time = stop;
+			next.paddle = lr;
+		}
+	}
+
+	return next;
+}
 
+void Game::Move(float dt) {
+	// Updates paddles positions
+	paddle_offsets[0].y += paddle_velocity[0] * dt;
+	paddle_offsets[1].y += paddle_velocity[1] * dt;
+
+	// Updates ball position
+	ball_offset.x += ball_velocity.x * dt;
+	ball_offset.y += ball_velocity.y * dt;
+}
+
+void Game::Resolve(const Contact& contact) {
+	switch (contact.event) {
+		case EVENT_WALL:
+			// Collision with top or bottom wall
+			ball_velocity.y *= -1;
+			break;
+
+		case EVENT_GOAL:
+			// Collision with left or right wall
+			winner = contact.winner;
+			Serve();
+			break;
+
+		case EVENT_PADDLE: {
+			float velocity = paddle_velocity[contact.paddle];
+			bool above = ball_offset.y > paddle_offsets[contact.paddle].y;
+
+			PaddleBounce(contact.paddle, contact.horizontal);
+
+			// A paddle catching up with the ball from behind would hit it again at once,
+			// it carries the ball instead
+			if (!contact.horizontal && above && ball_velocity.y <= velocity) {
+				ball_velocity.y = velocity + ball_min_velocity;
+			}
+			else if (!contact.horizontal && !above && ball_velocity.y >= velocity) {
+				ball_velocity.y = velocity - ball_min_velocity;
+			}
+
+			// A corner hit only flips one axis, if the ball still closes in on the corner
+			// along the other it would hit it again straight away
+			glm::vec2 relative = ball_offset - paddle_offsets[contact.paddle];
+			if (std::abs(relative.x) >= paddle_width / 2 && std::abs(relative.y) >= paddle_height / 2) {
+				float side_x = relative.x > 0 ? 1.0f : -1.0f;
+				float side_y = above ? 1.0f : -1.0f;
+
+				if (ball_velocity.x * side_x < 0.0f) {
+					ball_velocity.x *= -1;
+				}
+
+				if ((ball_velocity.y - velocity) * side_y < 0.0f) {
+					ball_velocity.y = velocity + side_y * std::max(std::abs(ball_velocity.y - velocity), ball_min_velocity);
+				}
+			}
+			break;
+		}
+
+		case EVENT_PADDLE_STOP:
+			paddle_offsets[contact.paddle].y = paddle_velocity[contact.paddle] > 0 ? height - paddle_boundary : paddle_boundary;
+			paddle_velocity[contact.paddle] = 0.0f;
+			break;
+
+		default:
+			break;
+	}
+
+	Separate();
+}
+
+void Game::Separate() {
+	for (int lr = 0; lr < 2; lr++) {
+		glm::vec2 relative = ball_offset - paddle_offsets[lr];
+		float overlap_x = paddle_width / 2 + ball_radius - std::abs(relative.x);
+		float overlap_y = paddle_height / 2 + ball_radius - std::abs(relative.y);
+
+		// Round corners, a ball diagonally off a corner can be inside both extents and still miss
+		glm::vec2 outside = glm::max(glm::abs(relative) - glm::vec2(paddle_width, paddle_height) / 2.0f, 0.0f);
+
+		if (overlap_x <= 0.0f || overlap_y <= 0.0f || glm::dot(outside, outside) >= ball_radius * ball_radius) {
+			continue;
+		}
+
+		// Out through the top/bottom only if the ball fits between the paddle and the wall
+		float side = relative.y > 0 ? 1.0f : -1.0f;
+		float pushed_y = ball_offset.y + side * overlap_y;
+		bool fits = pushed_y - ball_radius >= 0.0f && pushed_y + ball_radius <= height;
+
+		if (fits && overlap_y < overlap_x) {
+			ball_offset.y = pushed_y;
+
+			// Moving away from the paddle faster than it follows
+			float velocity = paddle_velocity[lr];
+			if ((ball_velocity.y - velocity) * side <= 0.0f) {
+				ball_velocity.y = velocity + side * std::max(std::abs(ball_velocity.y - velocity), ball_min_velocity);
+			}
+		}
+		else {
+			side = relative.x > 0 ? 1.0f : -1.0f;
+			ball_offset.x += side * overlap_x;
+
+			if (ball_velocity.x * side < 0.0f) {
+				ball_velocity.x *= -1;
+			}
+		}
+	}
 }
 
-void Game::Render() {
+void Game::PaddleBounce(int lr, bool horizontal) {
+	if (horizontal) {
+		// Horizontal collision (left/right of paddle)
+		ball_velocity.x *= -1;
+	}
+	else {
+		// Vertical collision (top/bottom of paddle)
+		ball_velocity.y *= -1;
+	}
+
+	// Speed up ball
+	ball_velocity.x *= 1.05f;
+	ball_velocity.y += 0.5f * paddle_velocity[lr];
+
+	// Checks for ball minimum and maximum velocities
+	if (std::abs(ball_velocity.y) < ball_min_velocity) {
+		ball_velocity.y = (ball_velocity.y > 0) ? ball_min_velocity : -ball_min_velocity;
+	}
 
-}
\ No newline at end of file
+	if (std::abs(ball_velocity.y) > ball_max_velocity) {
+		ball_velocity.y = (ball_velocity.y > 0) ? ball_max_velocity : -ball_max_velocity;
+	}
+
+	if (std::abs(ball_velocity.x) < ball_min_velocity) {
+		ball_velocity.x = (ball_velocity.x > 0) ? ball_min_velocity : -ball_min_velocity;
+	}
+
+	if (std::abs(ball_velocity.x) > ball_max_velocity) {
+		ball_velocity.x = (ball_velocity.x > 0) ? ball_max_velocity : -ball_max_velocity;
+	}
+}
+
+void Game::Serve() {
+	// Ball went through the left wall (0), so the right side scored, and vice versa
+	score[winner ? 0 : 1]++;
+	rallies++;
+
+	// Serves towards the side that just scored
+	ServeVelocity velocity = serveVelocity(seed, match, rallies, winner ? -1 : 1);
+	ball_velocity = { velocity.x, velocity.y };
+
+	ball_offset.x = width / 2.0f;
+	ball_offset.y = height / 2.0f;
+}
@@ -1,23 +1,94 @@
 #pragma once
 
+#include <glm/glm.hpp>
+
+#include "Collision.hpp"
+#include "Random.hpp"
+
+// Pure simulation core, no GL or GLFW dependency so it can be stepped headless
+
+const float ball_diameter = 14.0f;
+const float ball_radius = ball_diameter / 2.0f;
+
+const float paddle_height = 80.0f;
+const float paddle_width = 12.0f;
+const float paddle_speed = 150.0f;
+const float paddle_boundary = (paddle_height / 2.0f) + (ball_diameter / 2.0f);
+const float paddle_margin = 35.0f;
+
+const float ball_min_velocity = 20.0f;
+const float ball_max_velocity = 300.0f;
+
+// Collision frames, only MatchBatch's discrete step still uses a cooldown
+const int collision_threshold = 3;
+
+// Contacts resolved inside a single Update, past that the rest of the step moves without
+// collision checks and Game::Separate pushes the ball out of any paddle it ended up in
+const unsigned int max_contacts_per_update = 16;
+
+// Distance from a wall at which a ball counts as pinned by a paddle, only when the gap
+// between the paddle and that wall is narrower than the ball (within the same tolerance)
+const float squeeze_tolerance = 0.5f;
+
 enum GameState {
 	GAME_ACTIVE,
 	GAME_MENU,
 	GAME_WIN
 };
 
+// Paddle controls, filled by whoever drives the game (keyboard, bot, replay...)
+enum GameKey {
+	KEY_LEFT_UP,
+	KEY_LEFT_DOWN,
+	KEY_RIGHT_UP,
+	KEY_RIGHT_DOWN,
+	KEY_COUNT
+};
+
 class Game {
 	public:
 		GameState state;
-		bool keys[1024];
+		bool keys[KEY_COUNT];
 		unsigned int width, height;
 
-		Game(unsigned int width, unsigned int height);
+		glm::vec2 paddle_offsets[2];
+		float paddle_velocity[2];
+
+		glm::vec2 ball_offset;
+		glm::vec2 ball_velocity;
+
+		// Which side scored last, left (0) or right (1)
+		bool winner;
+		unsigned int score[2];
+		unsigned int rallies;
+
+		// Serve velocities are drawn from (seed, match, rallies)
+		uint64_t seed;
+		uint64_t match;
+
+		Game(unsigned int width, unsigned int height, uint64_t seed = 0, uint64_t match = 0);
 		~Game();
 
+		// Centers everything and serves the ball
 		void Init();
+		void Resize(unsigned int width, unsigned int height);
 
-		void ProcessInput(float dt);
+		// Sets paddle velocities from the held keys, Update does the moving
+		void ProcessInput();
+		// Moves everything dt seconds, resolving each contact at its exact time of impact
 		void Update(float dt);
-		void Render();
-};
\ No newline at end of file
+
+		// Earliest wall, goal, paddle hit or paddle stop from the current state
+		Contact NextContact() const;
+		// Moves in a straight line, callers make sure no contact happens within dt
+		void Move(float dt);
+		void Resolve(const Contact& contact);
+		// Pushes a ball that ended up inside a paddle back out and sends it away from it,
+		// swept tests only see hits that start outside
+		void Separate();
+
+		// Flips, speeds up and clamps the ball after it hits paddle lr on its side (horizontal) or top/bottom
+		void PaddleBounce(int lr, bool horizontal);
+		// Counts the point for the side opposite to winner, centers the ball and serves again
+		void Serve();
+};
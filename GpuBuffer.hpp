@@ -0,0 +1,220 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <utility>
+
+#include "GLState.hpp"
+
+// How a buffer's contents get replaced, which one is fastest depends on size, update
+// rate and driver, the buffer benchmark measures them
+enum BufferUpdate {
+	// Immutable storage filled once at creation, Update is not allowed
+	BUFFER_STATIC,
+	// glNamedBufferSubData into the same storage, may wait for draws still reading it
+	BUFFER_SUBDATA,
+	// glNamedBufferData(NULL) first so the driver hands out fresh storage, then subdata
+	BUFFER_ORPHAN,
+	// glMapNamedBufferRange with invalidate and unsynchronized bits, no waiting at all
+	BUFFER_MAP_UNSYNCHRONIZED,
+	// Mapped once, cycles through fenced regions and writes straight into them
+	BUFFER_PERSISTENT
+};
+
+inline const char* bufferUpdateName(BufferUpdate update) {
+	switch (update) {
+		case BUFFER_STATIC: return "static";
+		case BUFFER_SUBDATA: return "subdata";
+		case BUFFER_ORPHAN: return "orphan";
+		case BUFFER_MAP_UNSYNCHRONIZED: return "map unsynchronized";
+		case BUFFER_PERSISTENT: return "persistent";
+		default: return "unknown";
+	}
+}
+
+// Typed buffer object that owns its GL name, move-only. Delete() frees it early (needed
+// before the context goes away), otherwise the destructor does
+template <typename T>
+class GpuBuffer {
+	public:
+		static const unsigned int region_count = 3;
+
+		GLuint ID;
+		BufferUpdate update;
+
+		// Elements per update, a persistent buffer holds region_count times that
+		std::size_t count;
+
+		GpuBuffer() noexcept : ID(0), update(BUFFER_STATIC), count(0), region(0), region_size(0), mapping(NULL) {
+			for (unsigned int i = 0; i < region_count; i++) fences[i] = 0;
+		}
+
+		GpuBuffer(std::size_t count, BufferUpdate update, const T* data = NULL)
+			: update(update), count(count), region(region_count - 1), region_size(count * sizeof(T)), mapping(NULL) {
+			for (unsigned int i = 0; i < region_count; i++) fences[i] = 0;
+
+			glCreateBuffers(1, &ID);
+
+			if (update == BUFFER_STATIC) {
+				glNamedBufferStorage(ID, region_size, data, 0);
+			}
+			else if (update == BUFFER_PERSISTENT) {
+				// 256 satisfies the attribute, uniform and storage buffer offset alignments GL allows
+				region_size = (region_size + 255) / 256 * 256;
+
+				GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+				glNamedBufferStorage(ID, region_size * region_count, NULL, flags);
+				mapping = (unsigned char*)glMapNamedBufferRange(ID, 0, region_size * region_count, flags);
+
+				if (data) Update(data, count);
+			}
+			else {
+				glNamedBufferData(ID, region_size, data, GL_DYNAMIC_DRAW);
+			}
+		}
+
+		~GpuBuffer() {
+			Delete();
+		}
+
+		GpuBuffer(const GpuBuffer&) = delete;
+		GpuBuffer& operator=(const GpuBuffer&) = delete;
+
+		GpuBuffer(GpuBuffer&& other) noexcept : GpuBuffer() {
+			swap(other);
+		}
+
+		GpuBuffer& operator=(GpuBuffer&& other) noexcept {
+			if (this != &other) {
+				Delete();
+				swap(other);
+			}
+			return *this;
+		}
+
+		// Replaces the first count elements, returns the byte offset the data now starts at
+		// (only a persistent buffer moves, attributes have to be pointed there)
+		GLintptr Update(const T* data, std::size_t count) {
+			assert(count <= this->count);
+			GLsizeiptr size = count * sizeof(T);
+
+			switch (update) {
+				case BUFFER_SUBDATA:
+					glNamedBufferSubData(ID, 0, size, data);
+					return 0;
+
+				case BUFFER_ORPHAN:
+					glNamedBufferData(ID, region_size, NULL, GL_DYNAMIC_DRAW);
+					glNamedBufferSubData(ID, 0, size, data);
+					return 0;
+
+				case BUFFER_MAP_UNSYNCHRONIZED: {
+					GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT | GL_MAP_UNSYNCHRONIZED_BIT;
+					void* memory = glMapNamedBufferRange(ID, 0, size, flags);
+
+					// A failed map still has to land the data, subdata may wait but always works
+					if (!memory) {
+						glNamedBufferSubData(ID, 0, size, data);
+						return 0;
+					}
+
+					std::memcpy(memory, data, size);
+					glUnmapNamedBuffer(ID);
+					return 0;
+				}
+
+				case BUFFER_PERSISTENT:
+					std::memcpy(Next(), data, size);
+					return Offset();
+
+				default:
+					return 0;
+			}
+		}
+
+		// Subdata only, replaces count elements starting at element first and leaves the rest
+		void UpdateRange(std::size_t first, const T* data, std::size_t count) {
+			assert(first <= this->count && count <= this->count - first);
+
+			if (update == BUFFER_SUBDATA && count > 0) {
+				glNamedBufferSubData(ID, first * sizeof(T), count * sizeof(T), data);
+			}
+		}
+
+		// Persistent only, moves to the next region, waiting on its fence if the GPU still
+		// reads it, and returns where to write this update's elements
+		T* Next() {
+			region = (region + 1) % region_count;
+
+			if (fences[region]) {
+				GLenum status;
+				do {
+					status = glClientWaitSync(fences[region], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+				} while (status == GL_TIMEOUT_EXPIRED);
+
+				glDeleteSync(fences[region]);
+				fences[region] = 0;
+			}
+
+			return (T*)(mapping + region * region_size);
+		}
+
+		// Byte offset of the latest update
+		GLintptr Offset() const {
+			return update == BUFFER_PERSISTENT ? region * region_size : 0;
+		}
+
+		// Persistent only, call after the draws reading the current region have been issued
+		void Fence() {
+			if (update == BUFFER_PERSISTENT) {
+				fences[region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+			}
+		}
+
+		void Bind(GLenum target) {
+			GLState::BindBuffer(target, ID);
+		}
+
+		void Unbind(GLenum target) {
+			GLState::BindBuffer(target, 0);
+		}
+
+		void Delete() {
+			if (ID == 0) {
+				return;
+			}
+
+			for (unsigned int i = 0; i < region_count; i++) {
+				if (fences[i]) glDeleteSync(fences[i]);
+				fences[i] = 0;
+			}
+
+			if (mapping) {
+				glUnmapNamedBuffer(ID);
+				mapping = NULL;
+			}
+
+			GLState::ForgetBuffer(ID);
+			glDeleteBuffers(1, &ID);
+			ID = 0;
+		}
+
+	private:
+		unsigned int region;
+		GLsizeiptr region_size;
+		unsigned char* mapping;
+		GLsync fences[region_count];
+
+		void swap(GpuBuffer& other) noexcept {
+			std::swap(ID, other.ID);
+			std::swap(update, other.update);
+			std::swap(count, other.count);
+			std::swap(region, other.region);
+			std::swap(region_size, other.region_size);
+			std::swap(mapping, other.mapping);
+			for (unsigned int i = 0; i < region_count; i++) std::swap(fences[i], other.fences[i]);
+		}
+};
@@ -0,0 +1,245 @@
+#include <iostream>
+#include <chrono>
+#include <string>
+#include <algorithm>
+
+#include "Game.hpp"
+#include "MatchBatch.hpp"
+#include "BatchScheduler.hpp"
+#include "EventSimulation.hpp"
+#include "DeterministicMatch.hpp"
+#include "TextureBaker.hpp"
+
+// Runs matches without a window or GL context, as fast as the CPU allows
+// Usage: PongHeadless [rallies] [seed] [matches] [threads]
+//        PongHeadless --verify (checks SIMD collision kernels and serve draws against the scalar path)
+//        PongHeadless --events [rallies] [seed] (event driven simulation)
+//        PongHeadless --determinism [ticks] [seed] (fixed point lockstep check)
+//        PongHeadless --bake <image> <output> (bakes an image and its mips into a .ptex)
+
+// MatchBatch checks collisions once per tick and needs a small step, Game resolves
+// them at their exact time of impact and runs fine at a coarse one
+const float tick = 1.0f / 120.0f;
+const float game_tick = 1.0f / 30.0f;
+
+// Longest the event driven bot waits before looking at the ball again
+const float bot_reaction = 1.0f / 30.0f;
+
+// Simple bot, moves each paddle towards the ball's height
+void botInput(Game& game) {
+	for (int lr = 0; lr < 2; lr++) {
+		float delta = game.ball_offset.y - game.paddle_offsets[lr].y;
+
+		game.keys[lr == 0 ? KEY_LEFT_UP : KEY_RIGHT_UP] = delta > paddle_height / 4.0f;
+		game.keys[lr == 0 ? KEY_LEFT_DOWN : KEY_RIGHT_DOWN] = delta < -paddle_height / 4.0f;
+	}
+}
+
+// Same bot for every match of a batch
+void botInput(MatchBatch& batch, std::size_t begin, std::size_t end) {
+	for (std::size_t i = begin; i < end; i++) {
+		float left_delta = batch.ball_y[i] - batch.left_paddle_y[i];
+		float right_delta = batch.ball_y[i] - batch.right_paddle_y[i];
+
+		batch.left_input[i] = (left_delta > paddle_height / 4.0f) - (left_delta < -paddle_height / 4.0f);
+		batch.right_input[i] = (right_delta > paddle_height / 4.0f) - (right_delta < -paddle_height / 4.0f);
+	}
+}
+
+int runBatch(unsigned long long target_rallies, uint64_t seed, std::size_t matches) {
+	MatchBatch batch(matches, 800, 600, seed);
+	unsigned long long rallies = 0, ticks = 0;
+
+	std::cout << "Collision kernel: " << simdLevelName(batch.simd) << std::endl;
+
+	auto start = std::chrono::steady_clock::now();
+
+	while (rallies < target_rallies) {
+		botInput(batch, 0, batch.count);
+		batch.Step(tick);
+
+		rallies = batch.Rallies();
+		ticks++;
+	}
+
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	std::cout << "Matches: " << matches << " Rallies: " << rallies << " Ticks: " << ticks << " Time: " << seconds << "s" << std::endl;
+	std::cout << "Rallies/s: " << rallies / seconds << " Match ticks/s: " << ticks * matches / seconds << std::endl;
+
+	return 0;
+}
+
+// Jumps from event to event, the bot only decides at events or every bot_reaction seconds
+int runEvents(unsigned long long target_rallies, uint64_t seed) {
+	Game game(800, 600, seed);
+	EventSimulation simulation(game);
+
+	auto start = std::chrono::steady_clock::now();
+
+	while (game.rallies < target_rallies) {
+		bool keys[KEY_COUNT];
+		std::copy(game.keys, game.keys + KEY_COUNT, keys);
+
+		botInput(game);
+
+		// Only replans when the bot actually changed its mind
+		if (!std::equal(game.keys, game.keys + KEY_COUNT, keys)) {
+			simulation.Replan();
+		}
+
+		simulation.AdvanceToNextEvent(bot_reaction);
+	}
+
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	std::cout << "Rallies: " << game.rallies << " Events: " << simulation.events << " Simulated: " << simulation.time << "s Time: " << seconds << "s" << std::endl;
+	std::cout << "Rallies/s: " << game.rallies / seconds << " Simulated seconds/s: " << simulation.time / seconds << std::endl;
+	std::cout << "Score: " << game.score[0] << " - " << game.score[1] << std::endl;
+
+	return 0;
+}
+
+// Bot for the fixed point match, decides from the fixed point state only
+int8_t botInput(const DeterministicMatch& match, int lr) {
+	Fixed delta = match.ball_y - match.paddle_y[lr];
+	Fixed deadzone = Fixed::fromRatio(80, 4);
+
+	return (int8_t)((delta > deadzone) - (delta < -deadzone));
+}
+
+// Steps two matches with the same seed in lockstep and compares their hashes every tick,
+// the final hash is printed so runs on other builds and machines can be compared too
+int runDeterminism(unsigned long long ticks, unsigned long long seed) {
+	DeterministicMatch a(seed, 800, 600), b(seed, 800, 600);
+
+	auto start = std::chrono::steady_clock::now();
+
+	for (unsigned long long t = 0; t < ticks; t++) {
+		uint64_t hash_a = a.Step(botInput(a, 0), botInput(a, 1));
+		uint64_t hash_b = b.Step(botInput(b, 0), botInput(b, 1));
+
+		if (hash_a != hash_b) {
+			std::cout << "Desync at tick " << a.tick << std::endl;
+			return 1;
+		}
+	}
+
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	std::cout << "Ticks: " << ticks << " Time: " << seconds << "s Ticks/s: " << 2 * ticks / seconds << std::endl;
+	std::cout << "Score: " << a.score[0] << " - " << a.score[1] << std::endl;
+	std::cout << "Final hash: " << std::hex << a.hash << std::dec << std::endl;
+
+	return 0;
+}
+
+// Differential check of every collision kernel the CPU supports
+int verifyKernels() {
+	bool ok = true;
+
+	for (int level = SIMD_SSE41; level <= detectSimdLevel(); level++) {
+		bool match = true;
+
+		for (unsigned int seed = 1; seed <= 16 && match; seed++) {
+			match = collisionKernelsMatch((SimdLevel)level, 100003, seed);
+		}
+
+		std::cout << simdLevelName((SimdLevel)level) << (match ? " kernel matches scalar" : " kernel differs from scalar") << std::endl;
+		ok = ok && match;
+
+		if (level == SIMD_AVX2) {
+			bool serves_match = serveVelocitiesMatch(SIMD_AVX2, 100003, 1) && serveVelocitiesMatch(SIMD_AVX2, 100003, 2);
+
+			std::cout << simdLevelName((SimdLevel)level) << (serves_match ? " serves match scalar" : " serves differ from scalar") << std::endl;
+			ok = ok && serves_match;
+		}
+	}
+
+	return ok ? 0 : 1;
+}
+
+// Spreads the batch over a work stealing pool and reports each worker's share
+int runParallelBatch(unsigned long long target_rallies, uint64_t seed, std::size_t matches, unsigned int threads) {
+	MatchBatch batch(matches, 800, 600, seed);
+	WorkStealingPool pool(threads);
+
+	std::cout << "Collision kernel: " << simdLevelName(batch.simd) << " Threads: " << pool.Size()
+		<< " Chunk: " << batchChunkSize(matches, pool.Size()) << std::endl;
+
+	auto start = std::chrono::steady_clock::now();
+	simulateBatch(pool, batch, tick, target_rallies, botInput);
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	unsigned long long match_ticks = 0;
+
+	for (unsigned int i = 0; i < pool.Size(); i++) {
+		const WorkStealingPool::WorkerStats& stats = pool.Stats(i);
+		double busy = stats.busy_ns / 1e9;
+
+		std::cout << "Worker " << i << ": tasks " << stats.tasks << " steals " << stats.steals
+			<< " busy " << busy << "s match ticks/s " << (busy > 0 ? stats.work_units / busy : 0) << std::endl;
+
+		match_ticks += stats.work_units;
+	}
+
+	std::cout << "Matches: " << matches << " Rallies: " << batch.Rallies() << " Time: " << seconds << "s" << std::endl;
+	std::cout << "Rallies/s: " << batch.Rallies() / seconds << " Match ticks/s: " << match_ticks / seconds << std::endl;
+
+	return 0;
+}
+
+int main(int argc, char** argv) {
+	if (argc > 1 && std::string(argv[1]) == "--verify") {
+		return verifyKernels();
+	}
+
+	if (argc > 1 && std::string(argv[1]) == "--events") {
+		return runEvents(argc > 2 ? std::stoull(argv[2]) : 100000, argc > 3 ? std::stoull(argv[3]) : 1);
+	}
+
+	if (argc > 3 && std::string(argv[1]) == "--bake") {
+		return bakeTexture(argv[2], argv[3]) ? 0 : 1;
+	}
+
+	if (argc > 1 && std::string(argv[1]) == "--determinism") {
+		return runDeterminism(argc > 2 ? std::stoull(argv[2]) : 1000000, argc > 3 ? std::stoull(argv[3]) : 1);
+	}
+
+	unsigned long long target_rallies = argc > 1 ? std::stoull(argv[1]) : 100000;
+	uint64_t seed = argc > 2 ? std::stoull(argv[2]) : 1;
+	std::size_t matches = argc > 3 ? (std::size_t)std::stoull(argv[3]) : 1;
+	unsigned int threads = argc > 4 ? (unsigned int)std::stoul(argv[4]) : 1;
+
+	if (matches > 1 && threads > 1) {
+		return runParallelBatch(target_rallies, seed, matches, threads);
+	}
+
+	if (matches > 1) {
+		return runBatch(target_rallies, seed, matches);
+	}
+
+	Game game(800, 600, seed);
+	unsigned long long rallies = 0, ticks = 0;
+
+	auto start = std::chrono::steady_clock::now();
+
+	while (rallies < target_rallies) {
+		unsigned int before = game.rallies;
+
+		botInput(game);
+		game.ProcessInput();
+		game.Update(game_tick);
+
+		rallies += game.rallies - before;
+		ticks++;
+	}
+
+	double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+	std::cout << "Rallies: " << rallies << " Ticks: " << ticks << " Time: " << seconds << "s" << std::endl;
+	std::cout << "Rallies/s: " << rallies / seconds << " Ticks/s: " << ticks / seconds << std::endl;
+	std::cout << "Score: " << game.score[0] << " - " << game.score[1] << std::endl;
+
+	return 0;
+}
@@ -0,0 +1,21 @@
+#include "IndirectBuffer.hpp"
+
+#include "GLState.hpp"
+
+IndirectBuffer::IndirectBuffer(DrawElementsCommand* commands, GLsizeiptr size) {
+	glCreateBuffers(1, &ID);
+	glNamedBufferData(ID, size, commands, GL_STATIC_DRAW);
+}
+
+void IndirectBuffer::Bind() {
+	GLState::BindBuffer(GL_DRAW_INDIRECT_BUFFER, ID);
+}
+
+void IndirectBuffer::Unbind() {
+	GLState::BindBuffer(GL_DRAW_INDIRECT_BUFFER, 0);
+}
+
+void IndirectBuffer::Delete() {
+	GLState::ForgetBuffer(ID);
+	glDeleteBuffers(1, &ID);
+}
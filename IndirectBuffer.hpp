@@ -0,0 +1,24 @@
+#pragma once
+
+#include <glad/glad.h>
+
+// Layout glMultiDrawElementsIndirect reads for every draw
+struct DrawElementsCommand {
+	GLuint count;
+	GLuint instance_count;
+	GLuint first_index;
+	GLint base_vertex;
+	GLuint base_instance;
+};
+
+// Buffer of draw commands, bound to GL_DRAW_INDIRECT_BUFFER
+class IndirectBuffer {
+	public:
+		GLuint ID;
+
+		IndirectBuffer(DrawElementsCommand* commands, GLsizeiptr size);
+
+		void Bind();
+		void Unbind();
+		void Delete();
+};
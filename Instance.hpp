@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+
+#include <glm/glm.hpp>
+#include <glm/gtc/packing.hpp>
+
+// Shape cut out of the instance's quad by the fragment shader
+enum ShapeType {
+	SHAPE_BOX,
+	SHAPE_CIRCLE
+};
+
+// Layer value of shapes that only use their color
+const uint32_t instance_untextured = 0xFFFFFFFFu;
+
+// One drawn shape as default.vert reads it from the instance storage buffer, 32 bytes,
+// must match the std430 Instance struct there
+struct PackedInstance {
+	glm::vec2 offset;
+	// Width and height as two half floats
+	uint32_t size;
+	// RGB in the low three bytes, ShapeType in the high byte
+	uint32_t color_shape;
+	// Atlas region corners as two 16 bit unorms each
+	uint32_t uv_min;
+	uint32_t uv_max;
+	// Atlas array layer, or instance_untextured
+	uint32_t layer;
+	uint32_t padding;
+};
+
+// default.vert's Instance struct has the same fields in the same order, change both together
+static_assert(sizeof(PackedInstance) == 32, "PackedInstance must match default.vert's std430 Instance layout");
+
+// Textured shapes multiply their color with the atlas region uv = (u0, v0, u1, v1) of layer
+inline PackedInstance packInstance(glm::vec2 offset, glm::vec2 size, glm::vec3 color, ShapeType shape,
+	glm::vec4 uv = glm::vec4(0.0f, 0.0f, 1.0f, 1.0f), uint32_t layer = instance_untextured) {
+	glm::uvec3 rgb = glm::uvec3(glm::clamp(color, 0.0f, 1.0f) * 255.0f + 0.5f);
+
+	PackedInstance instance;
+	instance.offset = offset;
+	instance.size = glm::packHalf2x16(size);
+	instance.color_shape = rgb.r | (rgb.g << 8) | (rgb.b << 16) | ((uint32_t)shape << 24);
+	instance.uv_min = glm::packUnorm2x16(glm::vec2(uv.x, uv.y));
+	instance.uv_max = glm::packUnorm2x16(glm::vec2(uv.z, uv.w));
+	instance.layer = layer;
+	instance.padding = 0;
+	return instance;
+}
@@ -0,0 +1,28 @@
+#pragma once
+
+#include <cstddef>
+
+// Read-only memory mapping of a whole file, the OS pages it in on first touch
+class MappedFile {
+	public:
+		const unsigned char* data;
+		std::size_t size;
+
+		MappedFile();
+		~MappedFile();
+
+		MappedFile(const MappedFile&) = delete;
+		MappedFile& operator=(const MappedFile&) = delete;
+
+		// False if the file can't be opened or mapped, an empty file also fails
+		bool Open(const char* file_name);
+		void Close();
+
+	private:
+#ifdef _WIN32
+		void* file;
+		void* mapping;
+#else
+		int file;
+#endif
+};
@@ -0,0 +1,118 @@
+#include "MatchBatch.hpp"
+
+MatchBatch::MatchBatch(std::size_t count, unsigned int width, unsigned int height, uint64_t seed)
+	: count(count), width(width), height(height), seed(seed), simd(detectSimdLevel()),
+	ball_x(count), ball_y(count), velocity_x(count), velocity_y(count),
+	left_paddle_y(count), right_paddle_y(count), left_paddle_velocity(count), right_paddle_velocity(count),
+	left_input(count), right_input(count), collision_cooldown(count),
+	left_score(count), right_score(count) {
+	Init();
+}
+
+void MatchBatch::Init() {
+	for (std::size_t i = 0; i < count; i++) {
+		left_paddle_y[i] = height / 2.0f;
+		right_paddle_y[i] = height / 2.0f;
+		left_paddle_velocity[i] = 0.0f;
+		right_paddle_velocity[i] = 0.0f;
+		left_input[i] = 0;
+		right_input[i] = 0;
+
+		ball_x[i] = width / 2.0f;
+		ball_y[i] = height / 2.0f;
+
+		collision_cooldown[i] = 0;
+
+		left_score[i] = 0;
+		right_score[i] = 0;
+	}
+
+	// Every match is on its first serve, drawn all at once
+	std::vector<unsigned int> serves(count, 0);
+	serveVelocities(seed, 0, serves.data(), nullptr, count, velocity_x.data(), velocity_y.data(), simd);
+}
+
+void MatchBatch::Step(float dt) {
+	Step(dt, 0, count);
+}
+
+// Moves a paddle following Game::ProcessInput rules
+static inline float paddleVelocity(float& paddle_y, signed char input, float height) {
+	if (input > 0) {
+		if (paddle_y < height - paddle_boundary) {
+			return paddle_speed;
+		}
+		paddle_y = height - paddle_boundary;
+	}
+	else if (input < 0) {
+		if (paddle_y > paddle_boundary) {
+			return -paddle_speed;
+		}
+		paddle_y = paddle_boundary;
+	}
+
+	return 0.0f;
+}
+
+void MatchBatch::Step(float dt, std::size_t begin, std::size_t end) {
+	const float w = (float)width;
+	const float h = (float)height;
+
+	for (std::size_t i = begin; i < end; i++) {
+		left_paddle_velocity[i] = paddleVelocity(left_paddle_y[i], left_input[i], h);
+		right_paddle_velocity[i] = paddleVelocity(right_paddle_y[i], right_input[i], h);
+
+		// Collision with top or bottom wall
+		if (ball_y[i] - ball_radius <= 0 || ball_y[i] + ball_radius >= h) {
+			velocity_y[i] *= -1;
+			ball_y[i] += 0.1f * (ball_y[i] > h / 2 ? -1 : 1);
+		}
+
+		// Collision with left or right wall
+		if (ball_x[i] - ball_radius <= 0) {
+			serve(i, 0);
+		}
+		else if (ball_x[i] + ball_radius >= w) {
+			serve(i, 1);
+		}
+	}
+
+	// Paddle collision, vectorized across matches
+	collidePaddles(*this, begin, end, simd);
+
+	// Updates paddles and ball positions
+	for (std::size_t i = begin; i < end; i++) {
+		left_paddle_y[i] += left_paddle_velocity[i] * dt;
+		right_paddle_y[i] += right_paddle_velocity[i] * dt;
+
+		ball_x[i] += velocity_x[i] * dt;
+		ball_y[i] += velocity_y[i] * dt;
+	}
+}
+
+unsigned long long MatchBatch::Rallies() const {
+	unsigned long long rallies = 0;
+
+	for (std::size_t i = 0; i < count; i++) {
+		rallies += left_score[i] + right_score[i];
+	}
+
+	return rallies;
+}
+
+// Centers ball and reset velocity, winner is the wall the ball went through
+void MatchBatch::serve(std::size_t i, bool winner) {
+	if (winner) {
+		left_score[i]++;
+	}
+	else {
+		right_score[i]++;
+	}
+
+	ServeVelocity velocity = serveVelocity(seed, i, left_score[i] + right_score[i], winner ? -1 : 1);
+	velocity_x[i] = (float)velocity.x;
+	velocity_y[i] = (float)velocity.y;
+
+	ball_x[i] = width / 2.0f;
+	ball_y[i] = height / 2.0f;
+}
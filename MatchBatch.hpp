@@ -0,0 +1,49 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+
+#include "Game.hpp"
+#include "CollisionKernels.hpp"
+
+// N independent matches stored as structure of arrays, stepped together
+// Uses the same wall, paddle and velocity clamp rules as Game
+class MatchBatch {
+	public:
+		std::size_t count;
+		unsigned int width, height;
+
+		// Match i draws its serves from (seed, i, serves so far)
+		uint64_t seed;
+
+		// Instruction set used by the paddle collision pass
+		SimdLevel simd;
+
+		std::vector<float> ball_x, ball_y;
+		std::vector<float> velocity_x, velocity_y;
+
+		// Paddles only move vertically, x is fixed by width
+		std::vector<float> left_paddle_y, right_paddle_y;
+		std::vector<float> left_paddle_velocity, right_paddle_velocity;
+
+		// Paddle controls, -1 (down), 0 (idle) or 1 (up)
+		std::vector<signed char> left_input, right_input;
+
+		std::vector<int> collision_cooldown;
+
+		std::vector<unsigned int> left_score, right_score;
+
+		MatchBatch(std::size_t count, unsigned int width, unsigned int height, uint64_t seed = 0);
+
+		// Centers everything and serves every ball
+		void Init();
+
+		void Step(float dt);
+		// Steps only matches in [begin, end)
+		void Step(float dt, std::size_t begin, std::size_t end);
+
+		unsigned long long Rallies() const;
+
+	private:
+		void serve(std::size_t i, bool winner);
+};
@@ -0,0 +1,21 @@
+#pragma once
+
+#include <cstddef>
+
+#include <glad/glad.h>
+
+// Every shape, sprite and glyph is this unit quad scaled by its instance, the fragment
+// shader cuts the round ones out
+const GLfloat quad_vertices[] = {
+	 0.5f,  0.5f,
+	-0.5f,  0.5f,
+	-0.5f, -0.5f,
+	 0.5f, -0.5f
+};
+const std::size_t quad_vertex_floats = sizeof(quad_vertices) / sizeof(quad_vertices[0]);
+
+const GLuint quad_indices[] = {
+	0, 1, 2,
+	2, 3, 0
+};
+const GLsizei quad_index_count = sizeof(quad_indices) / sizeof(quad_indices[0]);
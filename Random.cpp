@@ -0,0 +1,188 @@
+#include "Random.hpp"
+
+#include <cstring>
+#include <vector>
+
+#include <glm/detail/setup.hpp>
+
+// Same split as CollisionKernels, the AVX2 path is only called after runtime detection
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+#	define RANDOM_X86
+#	include <immintrin.h>
+#	if GLM_COMPILER & GLM_COMPILER_VC
+#		define TARGET_AVX2
+#	else
+#		define TARGET_AVX2 __attribute__((target("avx2")))
+#	endif
+#endif
+
+static const uint64_t golden_gamma = 0x9E3779B97F4A7C15ull;
+
+static inline uint64_t mix64(uint64_t x) {
+	x = (x ^ (x >> 30)) * 0xBF58476D1CE4E5B9ull;
+	x = (x ^ (x >> 27)) * 0x94D049BB133111EBull;
+	return x ^ (x >> 31);
+}
+
+uint64_t randomBits(uint64_t seed, uint64_t stream, uint64_t counter) {
+	// Two rounds, the first turns (seed, stream) into an independent key
+	uint64_t key = mix64(seed + golden_gamma * (stream + 1));
+	return mix64(key + golden_gamma * (counter + 1));
+}
+
+// One draw covers a whole serve, low word for x, high word for y, top bits for signs
+static inline ServeVelocity serveFromBits(uint64_t bits, int direction) {
+	uint32_t low = (uint32_t)bits;
+	uint32_t high = (uint32_t)(bits >> 32);
+
+	int32_t x = randomRange(low, serve_min_speed_x, serve_max_speed_x);
+	int32_t y = randomRange(high, 0, serve_max_speed_y);
+
+	int32_t sign_x = direction != 0 ? direction : ((low & 1) ? -1 : 1);
+	int32_t sign_y = (high & 1) ? -1 : 1;
+
+	ServeVelocity velocity = { sign_x * x, sign_y * y };
+	return velocity;
+}
+
+ServeVelocity serveVelocity(uint64_t seed, uint64_t match, uint64_t serve, int direction) {
+	return serveFromBits(randomBits(seed, match, serve), direction);
+}
+
+static void serveVelocitiesScalar(uint64_t seed, uint64_t first_match, const unsigned int* serves,
+	const signed char* directions, std::size_t begin, std::size_t end, float* velocity_x, float* velocity_y) {
+
+	// The directions test is hoisted so the loop body has no data dependent choice in it
+	if (directions) {
+		for (std::size_t i = begin; i < end; i++) {
+			ServeVelocity velocity = serveFromBits(randomBits(seed, first_match + i, serves[i]), directions[i]);
+
+			velocity_x[i] = (float)velocity.x;
+			velocity_y[i] = (float)velocity.y;
+		}
+	}
+	else {
+		for (std::size_t i = begin; i < end; i++) {
+			ServeVelocity velocity = serveFromBits(randomBits(seed, first_match + i, serves[i]), 0);
+
+			velocity_x[i] = (float)velocity.x;
+			velocity_y[i] = (float)velocity.y;
+		}
+	}
+}
+
+#ifdef RANDOM_X86
+// AVX2 has no 64 bit multiply, the low 64 bits are lo*lo + ((lo*hi + hi*lo) << 32)
+TARGET_AVX2 static inline __m256i mullo64(__m256i a, __m256i b) {
+	__m256i low = _mm256_mul_epu32(a, b);
+	__m256i cross = _mm256_add_epi64(
+		_mm256_mul_epu32(_mm256_srli_epi64(a, 32), b),
+		_mm256_mul_epu32(a, _mm256_srli_epi64(b, 32)));
+	return _mm256_add_epi64(low, _mm256_slli_epi64(cross, 32));
+}
+
+TARGET_AVX2 static inline __m256i mix64(__m256i x) {
+	x = mullo64(_mm256_xor_si256(x, _mm256_srli_epi64(x, 30)), _mm256_set1_epi64x((long long)0xBF58476D1CE4E5B9ull));
+	x = mullo64(_mm256_xor_si256(x, _mm256_srli_epi64(x, 27)), _mm256_set1_epi64x((long long)0x94D049BB133111EBull));
+	return _mm256_xor_si256(x, _mm256_srli_epi64(x, 31));
+}
+
+// Four matches per iteration, lane for lane the same arithmetic as randomBits and serveFromBits
+TARGET_AVX2 static std::size_t serveVelocitiesAVX2(uint64_t seed, uint64_t first_match, const unsigned int* serves,
+	const signed char* directions, std::size_t count, float* velocity_x, float* velocity_y) {
+
+	const __m256i gamma = _mm256_set1_epi64x((long long)golden_gamma);
+	const __m256i one = _mm256_set1_epi64x(1);
+	const __m256i seeds = _mm256_set1_epi64x((long long)seed);
+	const __m256i range_x = _mm256_set1_epi64x(serve_max_speed_x - serve_min_speed_x);
+	const __m256i range_y = _mm256_set1_epi64x(serve_max_speed_y);
+	const __m128i min_x = _mm_set1_epi32(serve_min_speed_x);
+	const __m128i bit = _mm_set1_epi32(1);
+	// Low word of each 64 bit lane
+	const __m256i low_words = _mm256_setr_epi32(0, 2, 4, 6, 1, 3, 5, 7);
+
+	__m256i streams = _mm256_add_epi64(_mm256_set1_epi64x((long long)first_match), _mm256_setr_epi64x(1, 2, 3, 4));
+	std::size_t i = 0;
+
+	for (; i + 4 <= count; i += 4) {
+		__m256i counters = _mm256_add_epi64(_mm256_cvtepu32_epi64(_mm_loadu_si128((const __m128i*)(serves + i))), one);
+
+		__m256i key = mix64(_mm256_add_epi64(seeds, mullo64(gamma, streams)));
+		__m256i bits = mix64(_mm256_add_epi64(key, mullo64(gamma, counters)));
+		streams = _mm256_add_epi64(streams, _mm256_set1_epi64x(4));
+
+		// randomRange: (bits * range) >> 32 on each 32 bit half
+		__m256i x64 = _mm256_srli_epi64(_mm256_mul_epu32(bits, range_x), 32);
+		__m256i y64 = _mm256_srli_epi64(_mm256_mul_epu32(_mm256_srli_epi64(bits, 32), range_y), 32);
+
+		__m128i x = _mm_add_epi32(_mm256_castsi256_si128(_mm256_permutevar8x32_epi32(x64, low_words)), min_x);
+		__m128i y = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(y64, low_words));
+		__m128i low = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(bits, low_words));
+		__m128i high = _mm256_castsi256_si128(_mm256_permutevar8x32_epi32(_mm256_srli_epi64(bits, 32), low_words));
+
+		// All ones where the value gets negated, (v ^ m) - m
+		__m128i negate_x = _mm_sub_epi32(_mm_setzero_si128(), _mm_and_si128(low, bit));
+		__m128i negate_y = _mm_sub_epi32(_mm_setzero_si128(), _mm_and_si128(high, bit));
+
+		if (directions) {
+			int packed;
+			std::memcpy(&packed, directions + i, sizeof(packed));
+			__m128i direction = _mm_cvtepi8_epi32(_mm_cvtsi32_si128(packed));
+			__m128i forced = _mm_cmpeq_epi32(direction, _mm_setzero_si128());
+			negate_x = _mm_blendv_epi8(_mm_cmplt_epi32(direction, _mm_setzero_si128()), negate_x, forced);
+		}
+
+		x = _mm_sub_epi32(_mm_xor_si128(x, negate_x), negate_x);
+		y = _mm_sub_epi32(_mm_xor_si128(y, negate_y), negate_y);
+
+		_mm_storeu_ps(velocity_x + i, _mm_cvtepi32_ps(x));
+		_mm_storeu_ps(velocity_y + i, _mm_cvtepi32_ps(y));
+	}
+
+	return i;
+}
+#endif
+
+void serveVelocities(uint64_t seed, uint64_t first_match, const unsigned int* serves,
+	const signed char* directions, std::size_t count, float* velocity_x, float* velocity_y, SimdLevel level) {
+
+	std::size_t done = 0;
+
+#ifdef RANDOM_X86
+	if (level == SIMD_AVX2) {
+		done = serveVelocitiesAVX2(seed, first_match, serves, directions, count, velocity_x, velocity_y);
+	}
+#else
+	(void)level;
+#endif
+
+	// Tail, or everything when there is no vector path
+	serveVelocitiesScalar(seed, first_match, serves, directions, done, count, velocity_x, velocity_y);
+}
+
+bool serveVelocitiesMatch(SimdLevel level, std::size_t samples, uint64_t seed) {
+	std::vector<unsigned int> serves(samples);
+	std::vector<signed char> directions(samples);
+
+	for (std::size_t i = 0; i < samples; i++) {
+		uint64_t bits = randomBits(seed, ~0ull, i);
+		serves[i] = (unsigned int)bits;
+		directions[i] = (signed char)((int)((bits >> 32) % 3) - 1);
+	}
+
+	std::vector<float> expected_x(samples), expected_y(samples), actual_x(samples), actual_y(samples);
+
+	for (int forced = 0; forced < 2; forced++) {
+		const signed char* direction_data = forced ? directions.data() : nullptr;
+
+		serveVelocities(seed, seed * 7, serves.data(), direction_data, samples, expected_x.data(), expected_y.data(), SIMD_SCALAR);
+		serveVelocities(seed, seed * 7, serves.data(), direction_data, samples, actual_x.data(), actual_y.data(), level);
+
+		if (std::memcmp(expected_x.data(), actual_x.data(), samples * sizeof(float)) != 0 ||
+			std::memcmp(expected_y.data(), actual_y.data(), samples * sizeof(float)) != 0) {
+			return false;
+		}
+	}
+
+	return true;
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+
+#include "Simd.hpp"
+
+// Counter based random numbers, every draw is a pure function of (seed, stream, counter)
+// so matches never share generator state and any serve can be regenerated on its own
+
+// Serve speeds in whole units, x in [50, 150) and y in (-150, 150)
+const int32_t serve_min_speed_x = 50;
+const int32_t serve_max_speed_x = 150;
+const int32_t serve_max_speed_y = 150;
+
+struct ServeVelocity {
+	int32_t x, y;
+};
+
+// 64 random bits for the given key, SplitMix64 finalizer over a per stream key
+uint64_t randomBits(uint64_t seed, uint64_t stream, uint64_t counter);
+
+// Maps 32 random bits to [min, max) with a multiply instead of a modulo
+inline int32_t randomRange(uint32_t bits, int32_t min, int32_t max) {
+	return min + (int32_t)(((uint64_t)bits * (uint32_t)(max - min)) >> 32);
+}
+
+// Velocity of serve number serve in match match. direction forces the sign of x,
+// -1 or 1, or picks it at random when 0
+ServeVelocity serveVelocity(uint64_t seed, uint64_t match, uint64_t serve, int direction = 0);
+
+// Same draws for count matches at once, match first_match + i uses serves[i] and
+// directions[i] (random x signs when directions is null). SIMD_AVX2 draws four
+// matches per iteration, every level gives bit-identical results
+void serveVelocities(uint64_t seed, uint64_t first_match, const unsigned int* serves,
+	const signed char* directions, std::size_t count, float* velocity_x, float* velocity_y,
+	SimdLevel level = SIMD_SCALAR);
+
+// Draws random serves with the scalar and the given level and compares them bit by bit
+bool serveVelocitiesMatch(SimdLevel level, std::size_t samples, uint64_t seed);
@@ -0,0 +1,129 @@
+#include "ReadbackBenchmark.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+#include "SpriteBatch.hpp"
+#include "RenderTarget.hpp"
+#include "ReadbackRing.hpp"
+#include "FixedTimestep.hpp"
+#include "BallScene.hpp"
+
+// Seconds each readback mode runs for
+const double readback_benchmark_seconds = 3.0;
+const std::size_t readback_benchmark_balls = 10000;
+
+enum ReadbackMode {
+	READBACK_NONE,
+	READBACK_BLOCKING,
+	READBACK_RING
+};
+
+static const char* readbackModeName(ReadbackMode mode) {
+	switch (mode) {
+		case READBACK_NONE: return "none";
+		case READBACK_BLOCKING: return "glReadPixels";
+		case READBACK_RING: return "pbo ring";
+		default: return "unknown";
+	}
+}
+
+void benchmarkReadback(GLFWwindow* window, Shader& shader, int swap_interval) {
+	const ReadbackMode modes[] = { READBACK_NONE, READBACK_BLOCKING, READBACK_RING };
+
+	// Measures rendering and readback, not the display's refresh rate
+	glfwSwapInterval(0);
+
+	int width, height;
+	glfwGetFramebufferSize(window, &width, &height);
+
+	SpriteBatch batch;
+	RenderTarget target(width, height);
+	ReadbackRing ring(width, height);
+	std::vector<unsigned char> pixels(width * height * 4);
+
+	std::cout << std::left << std::setw(16) << "Readback" << std::setw(12) << "ms/frame" << std::setw(12) << "Collected"
+		<< std::setw(16) << "Latency frames" << "Stalls" << std::endl;
+
+	for (ReadbackMode mode : modes) {
+		// Same scene every run
+		BallScene scene(readback_benchmark_balls, (float)width, (float)height);
+
+		unsigned long long frames = 0, collected = 0, latency = 0;
+		unsigned long long stalls = ring.stalls;
+		uint64_t start = monotonicNanoseconds();
+		uint64_t last = start;
+
+		while (!glfwWindowShouldClose(window) && (monotonicNanoseconds() - start) / 1e9 < readback_benchmark_seconds) {
+			uint64_t now = monotonicNanoseconds();
+			float dt = (now - last) / 1e9f;
+			last = now;
+
+			scene.Step(dt);
+
+			for (std::size_t i = 0; i < readback_benchmark_balls; i++) {
+				batch.AddCircle(scene.positions[i], 4.0f);
+			}
+
+			target.Bind();
+			glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+			glClear(GL_COLOR_BUFFER_BIT);
+
+			shader.Activate();
+			batch.Flush();
+
+			target.Unbind();
+
+			if (mode == READBACK_BLOCKING) {
+				// Waits for the whole frame to finish rendering before returning
+				GLState::BindFramebuffer(GL_READ_FRAMEBUFFER, target.ID);
+				glPixelStorei(GL_PACK_ALIGNMENT, 1);
+				glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+				glPixelStorei(GL_PACK_ALIGNMENT, 4);
+				GLState::BindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+
+				collected++;
+			}
+			else if (mode == READBACK_RING) {
+				ring.Read(target);
+
+				unsigned long long frame;
+				while (ring.Collect(pixels, &frame)) {
+					latency += frames - frame;
+					collected++;
+				}
+			}
+
+			target.Blit(width, height);
+
+			glfwSwapBuffers(window);
+			glfwPollEvents();
+			frames++;
+		}
+
+		double seconds = (monotonicNanoseconds() - start) / 1e9;
+
+		// Closing the window can end a run before its first frame
+		if (frames == 0) {
+			break;
+		}
+
+		std::cout << std::left << std::setw(16) << readbackModeName(mode) << std::setw(12) << 1000.0 * seconds / frames
+			<< std::setw(12) << collected << std::setw(16) << (collected > 0 ? (double)latency / collected : 0.0)
+			<< ring.stalls - stalls << std::endl;
+	}
+
+	// Drains copies still in flight so their fences get deleted
+	while (ring.Pending() > 0) {
+		glFinish();
+		ring.Collect(pixels);
+	}
+
+	ring.Delete();
+	target.Delete();
+	batch.Delete();
+
+	glViewport(0, 0, width, height);
+	glfwSwapInterval(swap_interval);
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include "ShaderClass.hpp"
+
+// Renders a ball scene into a RenderTarget and compares frame times with no readback, a
+// blocking glReadPixels every frame and a ReadbackRing. shader must be the linked default program,
+// swap_interval is the app's own and is restored afterwards
+void benchmarkReadback(GLFWwindow* window, Shader& shader, int swap_interval);
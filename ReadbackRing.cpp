@@ -0,0 +1,97 @@
+#include "ReadbackRing.hpp"
+
+#include <cstring>
+
+#include "GLState.hpp"
+
+ReadbackRing::ReadbackRing(GLsizei width, GLsizei height)
+	: width(width), height(height), stalls(0), oldest(0), pending(0), frame(0) {
+	glCreateBuffers(ring_size, buffers);
+
+	for (unsigned int i = 0; i < ring_size; i++) {
+		glNamedBufferStorage(buffers[i], (GLsizeiptr)width * height * 4, NULL, GL_MAP_READ_BIT);
+		fences[i] = 0;
+		frames[i] = 0;
+	}
+}
+
+void ReadbackRing::Read(RenderTarget& target) {
+	// Ring full, the caller isn't collecting fast enough
+	if (pending == ring_size) {
+		stalls++;
+		copy(oldest, NULL);
+	}
+
+	unsigned int slot = (oldest + pending) % ring_size;
+
+	// Returns right away, the copy into the buffer happens on the GPU
+	GLState::BindFramebuffer(GL_READ_FRAMEBUFFER, target.ID);
+	glNamedFramebufferReadBuffer(target.ID, GL_COLOR_ATTACHMENT0);
+	GLState::BindBuffer(GL_PIXEL_PACK_BUFFER, buffers[slot]);
+
+	glPixelStorei(GL_PACK_ALIGNMENT, 1);
+	glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, (void*)0);
+	glPixelStorei(GL_PACK_ALIGNMENT, 4);
+
+	GLState::BindBuffer(GL_PIXEL_PACK_BUFFER, 0);
+	GLState::BindFramebuffer(GL_READ_FRAMEBUFFER, 0);
+
+	fences[slot] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+	frames[slot] = frame++;
+	pending++;
+}
+
+bool ReadbackRing::Collect(std::vector<unsigned char>& pixels, unsigned long long* frame) {
+	if (pending == 0) {
+		return false;
+	}
+
+	// Zero timeout only polls, the flush makes sure the fence reaches the GPU at all
+	GLenum status = glClientWaitSync(fences[oldest], GL_SYNC_FLUSH_COMMANDS_BIT, 0);
+	if (status == GL_TIMEOUT_EXPIRED || status == GL_WAIT_FAILED) {
+		return false;
+	}
+
+	if (frame) *frame = frames[oldest];
+	copy(oldest, &pixels);
+	return true;
+}
+
+unsigned int ReadbackRing::Pending() const {
+	return pending;
+}
+
+// Waits if the copy isn't done yet, hands the pixels out when asked and frees the slot
+void ReadbackRing::copy(unsigned int slot, std::vector<unsigned char>* pixels) {
+	GLenum status;
+	do {
+		status = glClientWaitSync(fences[slot], GL_SYNC_FLUSH_COMMANDS_BIT, 1000000);
+	} while (status == GL_TIMEOUT_EXPIRED);
+
+	glDeleteSync(fences[slot]);
+	fences[slot] = 0;
+
+	if (pixels) {
+		GLsizeiptr size = (GLsizeiptr)width * height * 4;
+		pixels->resize(size);
+
+		void* memory = glMapNamedBufferRange(buffers[slot], 0, size, GL_MAP_READ_BIT);
+		std::memcpy(pixels->data(), memory, size);
+		glUnmapNamedBuffer(buffers[slot]);
+	}
+
+	oldest = (oldest + 1) % ring_size;
+	pending--;
+}
+
+void ReadbackRing::Delete() {
+	for (unsigned int i = 0; i < ring_size; i++) {
+		if (fences[i]) glDeleteSync(fences[i]);
+		fences[i] = 0;
+
+		GLState::ForgetBuffer(buffers[i]);
+	}
+
+	glDeleteBuffers(ring_size, buffers);
+	pending = 0;
+}
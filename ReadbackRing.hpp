@@ -0,0 +1,42 @@
+#pragma once
+
+#include <vector>
+
+#include <glad/glad.h>
+
+#include "RenderTarget.hpp"
+
+// Reads render targets back to CPU memory without stalling. Each Read copies into the next
+// pixel pack buffer of a ring and fences it, Collect hands out a copy only once its fence
+// has signaled, so with three buffers frame N's pixels arrive around frame N + 2
+class ReadbackRing {
+	public:
+		static const unsigned int ring_size = 3;
+
+		GLsizei width, height;
+		// Reads that found the ring full and had to wait on, then drop, the oldest copy
+		unsigned long long stalls;
+
+		ReadbackRing(GLsizei width, GLsizei height);
+
+		// Queues a copy of target's color, which must match the ring's size
+		void Read(RenderTarget& target);
+
+		// Oldest finished copy as tightly packed RGBA8 rows, bottom row first. False while
+		// nothing has finished, never waits. frame is the number of the Read it came from
+		bool Collect(std::vector<unsigned char>& pixels, unsigned long long* frame = NULL);
+
+		unsigned int Pending() const;
+
+		void Delete();
+
+	private:
+		GLuint buffers[ring_size];
+		GLsync fences[ring_size];
+		unsigned long long frames[ring_size];
+
+		unsigned int oldest, pending;
+		unsigned long long frame;
+
+		void copy(unsigned int slot, std::vector<unsigned char>* pixels);
+};
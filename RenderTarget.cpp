@@ -0,0 +1,48 @@
+#include "RenderTarget.hpp"
+
+#include <iostream>
+
+#include "GLState.hpp"
+
+RenderTarget::RenderTarget(GLsizei width, GLsizei height) : width(width), height(height) {
+	color.type = GL_TEXTURE_2D;
+	glCreateTextures(GL_TEXTURE_2D, 1, &color.ID);
+	glTextureStorage2D(color.ID, 1, GL_RGBA8, width, height);
+
+	glTextureParameteri(color.ID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTextureParameteri(color.ID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTextureParameteri(color.ID, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTextureParameteri(color.ID, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+	glCreateFramebuffers(1, &ID);
+	glNamedFramebufferTexture(ID, GL_COLOR_ATTACHMENT0, color.ID, 0);
+
+	GLenum status = glCheckNamedFramebufferStatus(ID, GL_FRAMEBUFFER);
+	if (status != GL_FRAMEBUFFER_COMPLETE) {
+		std::cout << "ERROR::FRAMEBUFFER::INCOMPLETE\n" << std::hex << status << std::dec << std::endl;
+	}
+}
+
+void RenderTarget::Bind() {
+	GLState::BindFramebuffer(GL_FRAMEBUFFER, ID);
+	glViewport(0, 0, width, height);
+}
+
+void RenderTarget::Unbind() {
+	GLState::BindFramebuffer(GL_FRAMEBUFFER, 0);
+}
+
+void RenderTarget::Blit(GLsizei window_width, GLsizei window_height) {
+	glBlitNamedFramebuffer(ID, 0, 0, 0, width, height, 0, 0, window_width, window_height, GL_COLOR_BUFFER_BIT, GL_LINEAR);
+}
+
+void RenderTarget::Delete() {
+	GLState::ForgetFramebuffer(ID);
+	glDeleteFramebuffers(1, &ID);
+	ID = 0;
+
+	if (color.ID != 0) {
+		color.Delete();
+		color.ID = 0;
+	}
+}
@@ -0,0 +1,22 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include "Texture.hpp"
+
+// Offscreen framebuffer with one RGBA8 color texture, drawn into instead of the window
+class RenderTarget {
+	public:
+		GLuint ID;
+		Texture color;
+		GLsizei width, height;
+
+		RenderTarget(GLsizei width, GLsizei height);
+
+		// Also sets the viewport to the whole target, Unbind leaves restoring it to the caller
+		void Bind();
+		void Unbind();
+		// Copies the color texture to the window's framebuffer, stretched to its size
+		void Blit(GLsizei window_width, GLsizei window_height);
+		void Delete();
+};
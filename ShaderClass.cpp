@@ -1,5 +1,12 @@
 #include "ShaderClass.hpp"
 
+#include "GLState.hpp"
+
+#include <vector>
+
+// Start of every program binary cache file
+const char program_cache_magic[4] = { 'P', 'G', 'L', 'B' };
+
 std::string getFileContent(const char* filename) {
 	std::ifstream file(filename, std::ios::binary);
 
@@ -20,65 +27,316 @@ std::string getFileContent(const char* filename) {
 	throw(errno);
 };
 
+// FNV-1a over the sources and the driver strings, a binary only loads on the driver that made it
+static uint64_t programCacheKey(const std::string& vertex_code, const std::string& fragment_code) {
+	const GLubyte* driver[] = { glGetString(GL_VENDOR), glGetString(GL_RENDERER), glGetString(GL_VERSION) };
+
+	std::string key = vertex_code + '\0' + fragment_code;
+	for (const GLubyte* text : driver) {
+		key += '\0';
+		if (text) key += (const char*)text;
+	}
+
+	uint64_t hash = 0xCBF29CE484222325ull;
+	for (unsigned char c : key) {
+		hash = (hash ^ c) * 0x100000001B3ull;
+	}
+	return hash;
+}
+
+// KHR_parallel_shader_compile and its ARB twin share enum values, neither is in glad's core profile
+#ifndef GL_COMPLETION_STATUS_KHR
+#define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
+typedef void (APIENTRYP PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)(GLuint count);
+
+static bool parallel_compile = false;
+
+bool enableParallelShaderCompile(GLADloadproc load) {
+	GLint count = 0;
+	glGetIntegerv(GL_NUM_EXTENSIONS, &count);
+
+	for (GLint i = 0; i < count && !parallel_compile; i++) {
+		std::string extension = (const char*)glGetStringi(GL_EXTENSIONS, i);
+		parallel_compile = extension == "GL_KHR_parallel_shader_compile" || extension == "GL_ARB_parallel_shader_compile";
+	}
+
+	if (!parallel_compile) {
+		return false;
+	}
+
+	PFNGLMAXSHADERCOMPILERTHREADSKHRPROC max_threads = (PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)load("glMaxShaderCompilerThreadsKHR");
+	if (!max_threads) {
+		max_threads = (PFNGLMAXSHADERCOMPILERTHREADSKHRPROC)load("glMaxShaderCompilerThreadsARB");
+	}
+
+	// Lets the driver pick how many threads to use
+	if (max_threads) {
+		max_threads(0xFFFFFFFF);
+	}
+
+	return true;
+}
+
+// Whole info log of a shader or program, however long it is
+static std::string infoLog(GLuint object, bool program) {
+	GLint length = 0;
+	if (program) glGetProgramiv(object, GL_INFO_LOG_LENGTH, &length);
+	else glGetShaderiv(object, GL_INFO_LOG_LENGTH, &length);
+
+	if (length <= 0) {
+		return std::string();
+	}
+
+	std::string log(length, '\0');
+	if (program) glGetProgramInfoLog(object, length, NULL, &log[0]);
+	else glGetShaderInfoLog(object, length, NULL, &log[0]);
+
+	log.resize(length - 1);
+	return log;
+}
+
 void Shader::createShader(const char* vertex_file, const char* fragment_file) {
+	beginShader(vertex_file, fragment_file);
+	finishShader();
+}
+
+void Shader::beginShader(const char* vertex_file, const char* fragment_file) {
 	std::string vertex_code = getFileContent(vertex_file);
 	std::string fragment_code = getFileContent(fragment_file);
 
+	ready = false;
+	vertex_shader = 0;
+	fragment_shader = 0;
+
+	// Linked program from a previous run, skips compiling when sources and driver match
+	cache_file = std::string(vertex_file) + ".bin";
+	cache_key = programCacheKey(vertex_code, fragment_code);
+
+	if (loadProgramBinary(cache_file, cache_key)) {
+		reflect();
+		ready = true;
+		return;
+	}
+
 	const char* vertex_source = vertex_code.c_str();
 	const char* fragment_source = fragment_code.c_str();
 
-	// Vertex shader compiling
-	GLuint vertex_shader = glCreateShader(GL_VERTEX_SHADER);
-
+	// Nothing below waits on the compiler, results are checked in finishShader
+	vertex_shader = glCreateShader(GL_VERTEX_SHADER);
 	glShaderSource(vertex_shader, 1, &vertex_source, NULL);
 	glCompileShader(vertex_shader);
 
-	//Checks for vertex shader compilation
-	int  success;
-	char infoLog[512];
-
-	glGetShaderiv(vertex_shader, GL_COMPILE_STATUS, &success);
-	if (!success) {
-		glGetShaderInfoLog(vertex_shader, 512, NULL, infoLog);
-		std::cout << "ERROR::SHADER::VERTEX::COMPILATION_FAILED\n" << infoLog << std::endl;
-	}
-
-	// Fragament shader compiling
-	GLuint fragment_shader = glCreateShader(GL_FRAGMENT_SHADER);
-
+	fragment_shader = glCreateShader(GL_FRAGMENT_SHADER);
 	glShaderSource(fragment_shader, 1, &fragment_source, NULL);
 	glCompileShader(fragment_shader);
 
-	// Checks for fragment shader compiling
-	glGetShaderiv(fragment_shader, GL_COMPILE_STATUS, &success);
-	if (!success) {
-		glGetShaderInfoLog(fragment_shader, 512, NULL, infoLog);
-		std::cout << "ERROR::SHADER::FRAGMENT::COMPILATION_FAILED\n" << infoLog << std::endl;
-	}
-
 	ID = glCreateProgram();
 
 	// Attaches previous shaders to shader program
 	glAttachShader(ID, vertex_shader);
 	glAttachShader(ID, fragment_shader);
+	glProgramParameteri(ID, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
 	glLinkProgram(ID);
+}
+
+bool Shader::isReady() {
+	if (ready) {
+		return true;
+	}
+
+	// Without the extension asking for the status would block, so just finish
+	if (parallel_compile) {
+		GLint complete = GL_FALSE;
+		glGetProgramiv(ID, GL_COMPLETION_STATUS_KHR, &complete);
+
+		if (!complete) {
+			return false;
+		}
+	}
+
+	finishShader();
+	return true;
+}
+
+void Shader::finishShader() {
+	if (ready) {
+		return;
+	}
+
+	int success;
+
+	//Checks for vertex shader compilation
+	glGetShaderiv(vertex_shader, GL_COMPILE_STATUS, &success);
+	if (!success) {
+		std::cout << "ERROR::SHADER::VERTEX::COMPILATION_FAILED\n" << infoLog(vertex_shader, false) << std::endl;
+	}
+
+	// Checks for fragment shader compiling
+	glGetShaderiv(fragment_shader, GL_COMPILE_STATUS, &success);
+	if (!success) {
+		std::cout << "ERROR::SHADER::FRAGMENT::COMPILATION_FAILED\n" << infoLog(fragment_shader, false) << std::endl;
+	}
 
 	// Checks for shader program
 	glGetProgramiv(ID, GL_LINK_STATUS, &success);
 	if (!success) {
-		glGetShaderInfoLog(ID, 512, NULL, infoLog);
-		std::cout << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog << std::endl;
+		std::cout << "ERROR::SHADER::PROGRAM::LINKING_FAILED\n" << infoLog(ID, true) << std::endl;
 	}
 
 	// Delete vertex and fragment shader from memory
 	glDeleteShader(vertex_shader);
 	glDeleteShader(fragment_shader);
+	vertex_shader = 0;
+	fragment_shader = 0;
+
+	if (success) {
+		saveProgramBinary(cache_file, cache_key);
+	}
+
+	reflect();
+	ready = true;
+}
+
+// Cache file layout: magic, key, binary format, binary length, binary
+bool Shader::loadProgramBinary(const std::string& file_name, uint64_t key) {
+	std::ifstream file(file_name, std::ios::binary);
+	if (!file) {
+		return false;
+	}
+
+	char magic[4];
+	uint64_t file_key;
+	GLenum format;
+	GLint length;
+
+	file.read(magic, sizeof(magic));
+	file.read((char*)&file_key, sizeof(file_key));
+	file.read((char*)&format, sizeof(format));
+	file.read((char*)&length, sizeof(length));
+
+	if (!file || std::string(magic, 4) != std::string(program_cache_magic, 4) || file_key != key || length <= 0) {
+		return false;
+	}
+
+	std::vector<char> binary(length);
+	file.read(binary.data(), length);
+	if (!file) {
+		return false;
+	}
+
+	ID = glCreateProgram();
+	glProgramBinary(ID, format, binary.data(), length);
+
+	// Drivers reject binaries after updates even when the strings didn't change
+	GLint success;
+	glGetProgramiv(ID, GL_LINK_STATUS, &success);
+	if (!success) {
+		glDeleteProgram(ID);
+		ID = 0;
+		return false;
+	}
+
+	return true;
+}
+
+void Shader::saveProgramBinary(const std::string& file_name, uint64_t key) {
+	GLint formats = 0;
+	glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &formats);
+
+	GLint length = 0;
+	glGetProgramiv(ID, GL_PROGRAM_BINARY_LENGTH, &length);
+
+	if (formats == 0 || length <= 0) {
+		return;
+	}
+
+	std::vector<char> binary(length);
+	GLenum format;
+	glGetProgramBinary(ID, length, &length, &format, binary.data());
+
+	// A failed write only costs a compile next launch
+	std::ofstream file(file_name, std::ios::binary | std::ios::trunc);
+	file.write(program_cache_magic, sizeof(program_cache_magic));
+	file.write((const char*)&key, sizeof(key));
+	file.write((const char*)&format, sizeof(format));
+	file.write((const char*)&length, sizeof(length));
+	file.write(binary.data(), length);
+}
+
+// Reads every active uniform and attribute once so setters never query GL by name
+void Shader::reflect() {
+	uniforms.clear();
+	attributes.clear();
+
+	const GLenum interfaces[] = { GL_UNIFORM, GL_PROGRAM_INPUT };
+	const GLenum properties[] = { GL_NAME_LENGTH, GL_LOCATION, GL_TYPE, GL_ARRAY_SIZE };
+
+	for (GLenum program_interface : interfaces) {
+		std::unordered_map<std::string, ShaderVariable>& variables = program_interface == GL_UNIFORM ? uniforms : attributes;
+
+		GLint count = 0;
+		glGetProgramInterfaceiv(ID, program_interface, GL_ACTIVE_RESOURCES, &count);
+
+		for (GLint i = 0; i < count; i++) {
+			GLint values[4];
+			glGetProgramResourceiv(ID, program_interface, i, 4, properties, 4, NULL, values);
+
+			// Uniform block members and built-ins have no location
+			if (values[1] < 0) {
+				continue;
+			}
+
+			std::string name(values[0], '\0');
+			glGetProgramResourceName(ID, program_interface, i, values[0], NULL, &name[0]);
+			name.resize(values[0] - 1);
+
+			ShaderVariable variable = { values[1], (GLenum)values[2], values[3] };
+			variables[name] = variable;
+
+			std::size_t bracket = name.find("[0]");
+			if (bracket != std::string::npos && bracket + 3 == name.size()) {
+				variables[name.substr(0, bracket)] = variable;
+			}
+		}
+	}
+}
+
+GLint Shader::uniformLocation(const std::string& name) const {
+	std::unordered_map<std::string, ShaderVariable>::const_iterator it = uniforms.find(name);
+	return it != uniforms.end() ? it->second.location : -1;
+}
+
+GLint Shader::attributeLocation(const std::string& name) const {
+	std::unordered_map<std::string, ShaderVariable>::const_iterator it = attributes.find(name);
+	return it != attributes.end() ? it->second.location : -1;
+}
+
+void Shader::setInt(GLint location, GLint value) {
+	glProgramUniform1i(ID, location, value);
+}
+
+void Shader::setFloat(GLint location, GLfloat value) {
+	glProgramUniform1f(ID, location, value);
+}
+
+void Shader::setVec2(GLint location, const glm::vec2& value) {
+	glProgramUniform2f(ID, location, value.x, value.y);
+}
+
+void Shader::setVec4(GLint location, const glm::vec4& value) {
+	glProgramUniform4f(ID, location, value.x, value.y, value.z, value.w);
+}
+
+void Shader::setMat4(GLint location, const GLfloat* value) {
+	glProgramUniformMatrix4fv(ID, location, 1, GL_FALSE, value);
 }
 
 void Shader::Activate() {
-	glUseProgram(ID);
+	GLState::UseProgram(ID);
 }
 
 void Shader::Delete() {
+	GLState::ForgetProgram(ID);
 	glDeleteProgram(ID);
 }
\ No newline at end of file
@@ -1,22 +1,72 @@
 #pragma once
 
 #include <glad/glad.h>
+#include <glm/glm.hpp>
 #include <iostream>
 
 #include <string>
 #include <fstream>
 #include <sstream>
 #include <cerrno>
+#include <cstdint>
+#include <unordered_map>
 
 // Return file's content as a string
 std::string getFileContent(const char* filename);
 
+// Turns on KHR/ARB_parallel_shader_compile when the driver has it, returns whether it did.
+// Call once after loading GL, load is the same function given to glad
+bool enableParallelShaderCompile(GLADloadproc load);
+
+// Active uniform or attribute, as reported by the linked program
+struct ShaderVariable {
+	GLint location;
+	GLenum type;
+	GLint size;
+};
+
 class Shader {
 	public:
 		GLuint ID;
 
+		// Filled once after linking, arrays are also reachable without their "[0]"
+		std::unordered_map<std::string, ShaderVariable> uniforms;
+		std::unordered_map<std::string, ShaderVariable> attributes;
+
+		// Compiles and links, blocking until the program is usable
 		void createShader(const char* vertex_file, const char* fragment_file);
 
+		// Same in steps: begin queues the work, isReady polls it without blocking when
+		// parallel compile is on, finish waits for it. Use the program only once ready
+		void beginShader(const char* vertex_file, const char* fragment_file);
+		bool isReady();
+		void finishShader();
+
+		// -1 if the program has no such active uniform or attribute. Look locations up once
+		// the program is ready and keep them, the setters only take locations
+		GLint uniformLocation(const std::string& name) const;
+		GLint attributeLocation(const std::string& name) const;
+
+		// No need to activate the program first, location -1 is ignored
+		void setInt(GLint location, GLint value);
+		void setFloat(GLint location, GLfloat value);
+		void setVec2(GLint location, const glm::vec2& value);
+		void setVec4(GLint location, const glm::vec4& value);
+		void setMat4(GLint location, const GLfloat* value);
+
 		void Activate();
 		void Delete();
+
+	private:
+		// Compile state between beginShader and finishShader
+		bool ready;
+		GLuint vertex_shader, fragment_shader;
+		std::string cache_file;
+		uint64_t cache_key;
+
+		void reflect();
+
+		// Program binary disk cache, loading fails on any mismatch or driver rejection
+		bool loadProgramBinary(const std::string& file_name, uint64_t key);
+		void saveProgramBinary(const std::string& file_name, uint64_t key);
 };
\ No newline at end of file
@@ -0,0 +1,40 @@
+#include "Simd.hpp"
+
+#include <glm/detail/setup.hpp>
+
+// cpuid is only asked on x86, anything else runs the scalar paths
+#if GLM_ARCH & GLM_ARCH_SSE2_BIT
+#	define SIMD_X86
+#	if GLM_COMPILER & GLM_COMPILER_VC
+#		include <intrin.h>
+#		include <immintrin.h>
+#	endif
+#endif
+
+SimdLevel detectSimdLevel() {
+#if defined(SIMD_X86) && (GLM_COMPILER & GLM_COMPILER_VC)
+	int info[4];
+	__cpuid(info, 1);
+
+	bool sse41 = (info[2] & (1 << 19)) != 0;
+	bool os_avx = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0 && (_xgetbv(0) & 0x6) == 0x6;
+
+	__cpuidex(info, 7, 0);
+	bool avx2 = os_avx && (info[1] & (1 << 5)) != 0;
+
+	if (avx2) return SIMD_AVX2;
+	if (sse41) return SIMD_SSE41;
+#elif defined(SIMD_X86)
+	if (__builtin_cpu_supports("avx2")) return SIMD_AVX2;
+	if (__builtin_cpu_supports("sse4.1")) return SIMD_SSE41;
+#endif
+	return SIMD_SCALAR;
+}
+
+const char* simdLevelName(SimdLevel level) {
+	switch (level) {
+		case SIMD_SSE41: return "SSE4.1";
+		case SIMD_AVX2: return "AVX2";
+		default: return "Scalar";
+	}
+}
@@ -0,0 +1,12 @@
+#pragma once
+
+// Instruction sets the vectorized kernels can run on
+enum SimdLevel {
+	SIMD_SCALAR,
+	SIMD_SSE41,
+	SIMD_AVX2
+};
+
+// Best instruction set supported by the running CPU
+SimdLevel detectSimdLevel();
+const char* simdLevelName(SimdLevel level);
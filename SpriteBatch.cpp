@@ -0,0 +1,68 @@
+#include "SpriteBatch.hpp"
+
+#include <cstring>
+
+#include "Quad.hpp"
+
+SpriteBatch::SpriteBatch(std::size_t capacity)
+	: positions(quad_vertex_floats, BUFFER_STATIC, quad_vertices), ebo(quad_indices, sizeof(quad_indices)),
+	instances(capacity, BUFFER_PERSISTENT) {
+
+	vao.linkAttrib(positions, 0, 2, GL_FLOAT, 2 * sizeof(GLfloat), (void*)0, 0);
+	vao.linkElements(ebo);
+
+	staging.reserve(capacity);
+}
+
+void SpriteBatch::AddRect(glm::vec2 center, glm::vec2 size, glm::vec3 color) {
+	staging.push_back(packInstance(center, size, color, SHAPE_BOX));
+}
+
+void SpriteBatch::AddCircle(glm::vec2 center, float diameter, glm::vec3 color) {
+	staging.push_back(packInstance(center, glm::vec2(diameter), color, SHAPE_CIRCLE));
+}
+
+void SpriteBatch::AddSprite(glm::vec2 center, glm::vec2 size, const AtlasEntry& entry, glm::vec3 color, ShapeType shape) {
+	staging.push_back(packInstance(center, size, color, shape, entry.uv, entry.layer));
+}
+
+void SpriteBatch::Flush() {
+	if (staging.empty()) {
+		return;
+	}
+
+	if (staging.size() > instances.count) {
+		grow(staging.size());
+	}
+
+	std::memcpy(instances.Next(), staging.data(), staging.size() * sizeof(PackedInstance));
+
+	GLState::BindBufferRange(GL_SHADER_STORAGE_BUFFER, 0, instances.ID, instances.Offset(), staging.size() * sizeof(PackedInstance));
+	vao.Bind();
+	glDrawElementsInstancedBaseInstance(GL_TRIANGLES, quad_index_count, GL_UNSIGNED_INT, 0, (GLsizei)staging.size(), 0);
+
+	instances.Fence();
+	staging.clear();
+}
+
+std::size_t SpriteBatch::Capacity() const {
+	return instances.count;
+}
+
+// Doubles until count fits. The old buffer is deleted right away, GL keeps its storage
+// alive on its own until the draws already issued from it have finished
+void SpriteBatch::grow(std::size_t count) {
+	std::size_t capacity = instances.count > 0 ? instances.count : 1;
+	while (capacity < count) {
+		capacity *= 2;
+	}
+
+	instances = GpuBuffer<PackedInstance>(capacity, BUFFER_PERSISTENT);
+}
+
+void SpriteBatch::Delete() {
+	vao.Delete();
+	positions.Delete();
+	ebo.Delete();
+	instances.Delete();
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <vector>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "VAO.hpp"
+#include "EBO.hpp"
+#include "GpuBuffer.hpp"
+#include "Instance.hpp"
+#include "TextureAtlas.hpp"
+
+// Collects rects, circles and atlas sprites in a CPU array and draws them all with one instanced draw,
+// the instance buffer grows as needed. Uses default.vert's storage buffer layout, so
+// the default shader has to be active when flushing
+class SpriteBatch {
+	public:
+		std::vector<PackedInstance> staging;
+
+		SpriteBatch(std::size_t capacity = 1024);
+
+		void AddRect(glm::vec2 center, glm::vec2 size, glm::vec3 color = glm::vec3(1.0f));
+		void AddCircle(glm::vec2 center, float diameter, glm::vec3 color = glm::vec3(1.0f));
+		// The atlas texture has to be bound to the shader's atlas unit when flushing
+		void AddSprite(glm::vec2 center, glm::vec2 size, const AtlasEntry& entry, glm::vec3 color = glm::vec3(1.0f), ShapeType shape = SHAPE_BOX);
+
+		// Uploads and draws everything added since the last flush, then empties the batch
+		void Flush();
+
+		std::size_t Capacity() const;
+
+		void Delete();
+
+	private:
+		VAO vao;
+		GpuBuffer<GLfloat> positions;
+		EBO ebo;
+		GpuBuffer<PackedInstance> instances;
+
+		void grow(std::size_t count);
+};
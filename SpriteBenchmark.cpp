@@ -0,0 +1,72 @@
+#include "SpriteBenchmark.hpp"
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+
+#include "SpriteBatch.hpp"
+#include "FixedTimestep.hpp"
+#include "BallScene.hpp"
+
+// Seconds each instance count runs for
+const double sprite_benchmark_seconds = 3.0;
+
+void benchmarkSprites(GLFWwindow* window, Shader& shader, int swap_interval) {
+	const std::size_t ball_counts[] = { 10000, 100000, 1000000 };
+
+	// Measures rendering, not the display's refresh rate
+	glfwSwapInterval(0);
+
+	int width, height;
+	glfwGetFramebufferSize(window, &width, &height);
+
+	SpriteBatch batch;
+
+	std::cout << std::left << std::setw(12) << "Balls" << std::setw(12) << "Frames/s" << "ms/frame" << std::endl;
+
+	for (std::size_t count : ball_counts) {
+		BallScene scene(count, (float)width, (float)height);
+
+		unsigned int frames = 0;
+		uint64_t start = monotonicNanoseconds();
+		uint64_t last = start;
+
+		while (!glfwWindowShouldClose(window) && (monotonicNanoseconds() - start) / 1e9 < sprite_benchmark_seconds) {
+			uint64_t now = monotonicNanoseconds();
+			float dt = (now - last) / 1e9f;
+			last = now;
+
+			scene.Step(dt);
+
+			for (std::size_t i = 0; i < count; i++) {
+				glm::vec3 color = glm::vec3(0.5f) + glm::vec3(scene.velocities[i], -scene.velocities[i].x) / 300.0f;
+				batch.AddCircle(scene.positions[i], 4.0f, color);
+			}
+
+			glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+			glClear(GL_COLOR_BUFFER_BIT);
+
+			shader.Activate();
+			batch.Flush();
+
+			glfwSwapBuffers(window);
+			glfwPollEvents();
+			frames++;
+		}
+
+		double seconds = (monotonicNanoseconds() - start) / 1e9;
+
+		// Closing the window can end a run before its first frame
+		if (frames == 0) {
+			break;
+		}
+
+		std::cout << std::left << std::setw(12) << count << std::setw(12) << frames / seconds
+			<< 1000.0 * seconds / frames << std::endl;
+	}
+
+	std::cout << "Instance buffer capacity: " << batch.Capacity() << std::endl;
+
+	batch.Delete();
+	glfwSwapInterval(swap_interval);
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <glad/glad.h>
+#include <GLFW/glfw3.h>
+
+#include "ShaderClass.hpp"
+
+// Chaos scene, bounces 10k, 100k and 1M balls around the window through a SpriteBatch
+// and reports frames per second for each. shader must be the linked default program,
+// swap_interval is the app's own and is restored afterwards
+void benchmarkSprites(GLFWwindow* window, Shader& shader, int swap_interval);
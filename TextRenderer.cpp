@@ -0,0 +1,256 @@
+#include "TextRenderer.hpp"
+
+#include <algorithm>
+
+#include "GLState.hpp"
+#include "Quad.hpp"
+
+// Rows top to bottom, bit 4 is the leftmost pixel, ' ' to 'Z'
+static const unsigned char font[91 - 32][7] = {
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00 }, // ' '
+	{ 0x04, 0x04, 0x04, 0x04, 0x04, 0x00, 0x04 }, // '!'
+	{ 0x0A, 0x0A, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '"'
+	{ 0x0A, 0x0A, 0x1F, 0x0A, 0x1F, 0x0A, 0x0A }, // '#'
+	{ 0x04, 0x0F, 0x14, 0x0E, 0x05, 0x1E, 0x04 }, // '$'
+	{ 0x18, 0x19, 0x02, 0x04, 0x08, 0x13, 0x03 }, // '%'
+	{ 0x0C, 0x12, 0x14, 0x08, 0x15, 0x12, 0x0D }, // '&'
+	{ 0x04, 0x04, 0x00, 0x00, 0x00, 0x00, 0x00 }, // '''
+	{ 0x02, 0x04, 0x08, 0x08, 0x08, 0x04, 0x02 }, // '('
+	{ 0x08, 0x04, 0x02, 0x02, 0x02, 0x04, 0x08 }, // ')'
+	{ 0x00, 0x04, 0x15, 0x0E, 0x15, 0x04, 0x00 }, // '*'
+	{ 0x00, 0x04, 0x04, 0x1F, 0x04, 0x04, 0x00 }, // '+'
+	{ 0x00, 0x00, 0x00, 0x00, 0x0C, 0x04, 0x08 }, // ','
+	{ 0x00, 0x00, 0x00, 0x1F, 0x00, 0x00, 0x00 }, // '-'
+	{ 0x00, 0x00, 0x00, 0x00, 0x00, 0x0C, 0x0C }, // '.'
+	{ 0x00, 0x01, 0x02, 0x04, 0x08, 0x10, 0x00 }, // '/'
+	{ 0x0E, 0x11, 0x13, 0x15, 0x19, 0x11, 0x0E }, // '0'
+	{ 0x04, 0x0C, 0x04, 0x04, 0x04, 0x04, 0x0E }, // '1'
+	{ 0x0E, 0x11, 0x01, 0x02, 0x04, 0x08, 0x1F }, // '2'
+	{ 0x1F, 0x02, 0x04, 0x02, 0x01, 0x11, 0x0E }, // '3'
+	{ 0x02, 0x06, 0x0A, 0x12, 0x1F, 0x02, 0x02 }, // '4'
+	{ 0x1F, 0x10, 0x1E, 0x01, 0x01, 0x11, 0x0E }, // '5'
+	{ 0x06, 0x08, 0x10, 0x1E, 0x11, 0x11, 0x0E }, // '6'
+	{ 0x1F, 0x01, 0x02, 0x04, 0x08, 0x08, 0x08 }, // '7'
+	{ 0x0E, 0x11, 0x11, 0x0E, 0x11, 0x11, 0x0E }, // '8'
+	{ 0x0E, 0x11, 0x11, 0x0F, 0x01, 0x02, 0x0C }, // '9'
+	{ 0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x0C, 0x00 }, // ':'
+	{ 0x00, 0x0C, 0x0C, 0x00, 0x0C, 0x04, 0x08 }, // ';'
+	{ 0x02, 0x04, 0x08, 0x10, 0x08, 0x04, 0x02 }, // '<'
+	{ 0x00, 0x00, 0x1F, 0x00, 0x1F, 0x00, 0x00 }, // '='
+	{ 0x08, 0x04, 0x02, 0x01, 0x02, 0x04, 0x08 }, // '>'
+	{ 0x0E, 0x11, 0x01, 0x02, 0x04, 0x00, 0x04 }, // '?'
+	{ 0x0E, 0x11, 0x01, 0x0D, 0x15, 0x15, 0x0E }, // '@'
+	{ 0x0E, 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11 }, // 'A'
+	{ 0x1E, 0x11, 0x11, 0x1E, 0x11, 0x11, 0x1E }, // 'B'
+	{ 0x0E, 0x11, 0x10, 0x10, 0x10, 0x11, 0x0E }, // 'C'
+	{ 0x1C, 0x12, 0x11, 0x11, 0x11, 0x12, 0x1C }, // 'D'
+	{ 0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x1F }, // 'E'
+	{ 0x1F, 0x10, 0x10, 0x1E, 0x10, 0x10, 0x10 }, // 'F'
+	{ 0x0E, 0x11, 0x10, 0x17, 0x11, 0x11, 0x0F }, // 'G'
+	{ 0x11, 0x11, 0x11, 0x1F, 0x11, 0x11, 0x11 }, // 'H'
+	{ 0x0E, 0x04, 0x04, 0x04, 0x04, 0x04, 0x0E }, // 'I'
+	{ 0x07, 0x02, 0x02, 0x02, 0x02, 0x12, 0x0C }, // 'J'
+	{ 0x11, 0x12, 0x14, 0x18, 0x14, 0x12, 0x11 }, // 'K'
+	{ 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x1F }, // 'L'
+	{ 0x11, 0x1B, 0x15, 0x15, 0x11, 0x11, 0x11 }, // 'M'
+	{ 0x11, 0x11, 0x19, 0x15, 0x13, 0x11, 0x11 }, // 'N'
+	{ 0x0E, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E }, // 'O'
+	{ 0x1E, 0x11, 0x11, 0x1E, 0x10, 0x10, 0x10 }, // 'P'
+	{ 0x0E, 0x11, 0x11, 0x11, 0x15, 0x12, 0x0D }, // 'Q'
+	{ 0x1E, 0x11, 0x11, 0x1E, 0x14, 0x12, 0x11 }, // 'R'
+	{ 0x0F, 0x10, 0x10, 0x0E, 0x01, 0x01, 0x1E }, // 'S'
+	{ 0x1F, 0x04, 0x04, 0x04, 0x04, 0x04, 0x04 }, // 'T'
+	{ 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x0E }, // 'U'
+	{ 0x11, 0x11, 0x11, 0x11, 0x11, 0x0A, 0x04 }, // 'V'
+	{ 0x11, 0x11, 0x11, 0x15, 0x15, 0x15, 0x0A }, // 'W'
+	{ 0x11, 0x11, 0x0A, 0x04, 0x0A, 0x11, 0x11 }, // 'X'
+	{ 0x11, 0x11, 0x11, 0x0A, 0x04, 0x04, 0x04 }, // 'Y'
+	{ 0x1F, 0x01, 0x02, 0x04, 0x08, 0x10, 0x1F }  // 'Z'
+};
+
+static const int glyph_count = 91 - 32;
+
+// Empty pixel border around each glyph in the atlas
+static const int glyph_padding = 1;
+
+TextRenderer::TextRenderer(std::size_t capacity)
+	: glyphs(capacity), dirty_first(0), dirty_end(0),
+	positions(quad_vertex_floats, BUFFER_STATIC, quad_vertices), ebo(quad_indices, sizeof(quad_indices)),
+	instances(capacity, BUFFER_SUBDATA) {
+
+	vao.linkAttrib(positions, 0, 2, GL_FLOAT, 2 * sizeof(GLfloat), (void*)0, 0);
+	vao.linkElements(ebo);
+
+	// Zero sized instances draw nothing, so unused slots stay in the single draw for free
+	std::fill(glyphs.begin(), glyphs.end(), packInstance(glm::vec2(0.0f), glm::vec2(0.0f), glm::vec3(0.0f), SHAPE_BOX));
+	instances.UpdateRange(0, glyphs.data(), glyphs.size());
+
+	bakeAtlas();
+}
+
+// One layer array texture so it samples through default.frag's atlas uniform
+void TextRenderer::bakeAtlas() {
+	const int cell_width = glyph_width + 2 * glyph_padding;
+	const int cell_height = glyph_height + 2 * glyph_padding;
+	const int width = cell_width * glyph_count;
+
+	std::vector<unsigned char> pixels(width * cell_height, 0);
+
+	for (int g = 0; g < glyph_count; g++) {
+		for (int row = 0; row < glyph_height; row++) {
+			// Texture rows go bottom to top
+			int y = glyph_padding + glyph_height - 1 - row;
+
+			for (int column = 0; column < glyph_width; column++) {
+				if (font[g][row] & (0x10 >> column)) {
+					pixels[y * width + g * cell_width + glyph_padding + column] = 255;
+				}
+			}
+		}
+
+		float x = (float)(g * cell_width + glyph_padding);
+		glyph_uv[g] = glm::vec4(x / width, (float)glyph_padding / cell_height,
+			(x + glyph_width) / width, (float)(glyph_padding + glyph_height) / cell_height);
+	}
+
+	atlas.type = GL_TEXTURE_2D_ARRAY;
+	glCreateTextures(GL_TEXTURE_2D_ARRAY, 1, &atlas.ID);
+	glTextureStorage3D(atlas.ID, 1, GL_R8, width, cell_height, 1);
+
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	glTextureSubImage3D(atlas.ID, 0, 0, 0, 0, width, cell_height, 1, GL_RED, GL_UNSIGNED_BYTE, pixels.data());
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+	// Glyphs are white, the single channel becomes alpha so the tint colors them
+	const GLint swizzle[] = { GL_ONE, GL_ONE, GL_ONE, GL_RED };
+	glTextureParameteriv(atlas.ID, GL_TEXTURE_SWIZZLE_RGBA, swizzle);
+
+	// Pixel font, kept sharp at any size
+	glTextureParameteri(atlas.ID, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+	glTextureParameteri(atlas.ID, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+	glTextureParameteri(atlas.ID, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTextureParameteri(atlas.ID, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+}
+
+unsigned int TextRenderer::AddText(glm::vec2 position, float height, unsigned int length, glm::vec3 color) {
+	unsigned int first = texts.empty() ? 0 : texts.back().first + texts.back().length;
+
+	// Grows the CPU copy, the buffer itself is recreated on the next draw
+	if (first + length > glyphs.size()) {
+		glyphs.resize(std::max<std::size_t>(first + length, glyphs.size() * 2),
+			packInstance(glm::vec2(0.0f), glm::vec2(0.0f), glm::vec3(0.0f), SHAPE_BOX));
+	}
+
+	Text text = { position, height, color, first, length, std::string() };
+	texts.push_back(text);
+
+	return (unsigned int)texts.size() - 1;
+}
+
+void TextRenderer::SetText(unsigned int text, const std::string& string) {
+	Text& target = texts[text];
+	std::string cut = string.substr(0, target.length);
+
+	if (cut == target.string) {
+		return;
+	}
+
+	target.string = cut;
+	layout(target);
+}
+
+void TextRenderer::SetColor(unsigned int text, glm::vec3 color) {
+	Text& target = texts[text];
+
+	if (target.color == color) {
+		return;
+	}
+
+	target.color = color;
+	layout(target);
+}
+
+void TextRenderer::SetPosition(unsigned int text, glm::vec2 position) {
+	Text& target = texts[text];
+
+	if (target.position == position) {
+		return;
+	}
+
+	target.position = position;
+	layout(target);
+}
+
+// Rewrites the text's whole range, slots past the string end are zero sized
+void TextRenderer::layout(Text& text) {
+	float scale = text.height / glyph_height;
+	glm::vec2 size = glm::vec2(glyph_width, glyph_height) * scale;
+	// One empty pixel column between glyphs
+	float advance = (glyph_width + 1) * scale;
+
+	for (unsigned int i = 0; i < text.length; i++) {
+		PackedInstance& glyph = glyphs[text.first + i];
+		int c = i < text.string.size() ? (unsigned char)text.string[i] : ' ';
+
+		if (c >= 'a' && c <= 'z') c -= 'a' - 'A';
+		if (c < 32 || c >= 32 + glyph_count) c = '?';
+
+		// Spaces only move the pen
+		if (i >= text.string.size() || c == ' ') {
+			glyph = packInstance(glm::vec2(0.0f), glm::vec2(0.0f), glm::vec3(0.0f), SHAPE_BOX);
+			continue;
+		}
+
+		glm::vec2 center = text.position + glm::vec2(advance * i, 0.0f) + size * 0.5f;
+		glyph = packInstance(center, size, text.color, SHAPE_BOX, glyph_uv[c - 32], 0);
+	}
+
+	if (dirty_first == dirty_end) {
+		dirty_first = text.first;
+		dirty_end = text.first + text.length;
+	}
+	else {
+		dirty_first = std::min<std::size_t>(dirty_first, text.first);
+		dirty_end = std::max<std::size_t>(dirty_end, text.first + text.length);
+	}
+}
+
+void TextRenderer::Draw() {
+	if (texts.empty()) {
+		return;
+	}
+
+	std::size_t count = texts.back().first + texts.back().length;
+
+	if (glyphs.size() > instances.count) {
+		instances = GpuBuffer<PackedInstance>(glyphs.size(), BUFFER_SUBDATA);
+		dirty_first = 0;
+		dirty_end = glyphs.size();
+	}
+
+	// Nothing is uploaded on frames where no string changed
+	if (dirty_first != dirty_end) {
+		instances.UpdateRange(dirty_first, glyphs.data() + dirty_first, dirty_end - dirty_first);
+		dirty_first = 0;
+		dirty_end = 0;
+	}
+
+	GLState::ActiveTexture(GL_TEXTURE0);
+	atlas.Bind();
+
+	GLState::BindBufferRange(GL_SHADER_STORAGE_BUFFER, 0, instances.ID, 0, count * sizeof(PackedInstance));
+	vao.Bind();
+	glDrawElementsInstancedBaseInstance(GL_TRIANGLES, quad_index_count, GL_UNSIGNED_INT, 0, (GLsizei)count, 0);
+}
+
+void TextRenderer::Delete() {
+	vao.Delete();
+	positions.Delete();
+	ebo.Delete();
+	instances.Delete();
+
+	if (atlas.ID != 0) {
+		atlas.Delete();
+		atlas.ID = 0;
+	}
+}
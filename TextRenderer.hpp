@@ -0,0 +1,68 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "VAO.hpp"
+#include "EBO.hpp"
+#include "GpuBuffer.hpp"
+#include "Instance.hpp"
+#include "Texture.hpp"
+
+// Draws strings with a built-in 5x7 pixel font baked once into a glyph atlas. Each text
+// owns a fixed range of glyph instances in one buffer, only ranges whose string changed
+// are uploaded, and every text goes out in a single instanced draw. Uses default.vert's
+// storage buffer layout and binds the glyph atlas to texture unit 0 (the atlas sampler)
+class TextRenderer {
+	public:
+		// Font cell in atlas pixels, glyphs cover ' ' to 'Z', lowercase is drawn as uppercase
+		static const int glyph_width = 5;
+		static const int glyph_height = 7;
+
+		Texture atlas;
+
+		TextRenderer(std::size_t capacity = 1024);
+
+		// Reserves room for length glyphs, position is the bottom left corner and height the
+		// glyph height in pixels. Returns the handle SetText takes
+		unsigned int AddText(glm::vec2 position, float height, unsigned int length, glm::vec3 color = glm::vec3(1.0f));
+
+		// Lays the string out again only if it differs from the current one, extra
+		// characters past the reserved length are cut off
+		void SetText(unsigned int text, const std::string& string);
+		void SetColor(unsigned int text, glm::vec3 color);
+		void SetPosition(unsigned int text, glm::vec2 position);
+
+		// Uploads the changed ranges and draws every text
+		void Draw();
+
+		void Delete();
+
+	private:
+		struct Text {
+			glm::vec2 position;
+			float height;
+			glm::vec3 color;
+			unsigned int first, length;
+			std::string string;
+		};
+
+		std::vector<Text> texts;
+		std::vector<PackedInstance> glyphs;
+		// Atlas region of each character
+		glm::vec4 glyph_uv[91 - 32];
+
+		// Glyph instances to upload on the next draw, empty when first == end
+		std::size_t dirty_first, dirty_end;
+
+		VAO vao;
+		GpuBuffer<GLfloat> positions;
+		EBO ebo;
+		GpuBuffer<PackedInstance> instances;
+
+		void bakeAtlas();
+		void layout(Text& text);
+};
@@ -1,15 +1,66 @@
 #include "Texture.hpp"
 
+#include "GLState.hpp"
+
+#include <algorithm>
+
+GLenum textureInternalFormat(int channels) {
+	switch (channels) {
+		case 1: return GL_R8;
+		case 2: return GL_RG8;
+		case 3: return GL_RGB8;
+		default: return GL_RGBA8;
+	}
+}
+
+GLenum textureFormat(int channels) {
+	switch (channels) {
+		case 1: return GL_RED;
+		case 2: return GL_RG;
+		case 3: return GL_RGB;
+		default: return GL_RGBA;
+	}
+}
+
+int textureChannels(GLenum format) {
+	switch (format) {
+		case GL_RED: return 1;
+		case GL_RG: return 2;
+		case GL_RGB: return 3;
+		default: return 4;
+	}
+}
+
+GLsizei textureLevels(int width, int height) {
+	GLsizei levels = 1;
+	for (int size = std::max(width, height); size > 1; size /= 2) {
+		levels++;
+	}
+	return levels;
+}
+
+Texture::Texture() : ID(0), type(GL_TEXTURE_2D) {
+}
+
 Texture::Texture(const char* image, GLenum texture_type, GLenum slot, GLenum format, GLenum pixel_type) {
 	type = texture_type;
+	ID = 0;
+
+	// Decodes to as many channels as format has, so the upload never reads past bytes
+	int channels = textureChannels(format);
 
 	int width_img, height_img, col_channels;
 	stbi_set_flip_vertically_on_load(true);
-	unsigned char* bytes = stbi_load(image, &width_img, &height_img, &col_channels, 0);
+	unsigned char* bytes = stbi_load(image, &width_img, &height_img, &col_channels, channels);
+
+	if (!bytes) {
+		std::cout << "ERROR::TEXTURE::LOADING_FAILED " << image << "\n" << stbi_failure_reason() << std::endl;
+		return;
+	}
 
 	glGenTextures(1, &ID);
-	glActiveTexture(slot);
-	glBindTexture(texture_type, ID);
+	GLState::ActiveTexture(slot);
+	GLState::BindTexture(texture_type, ID);
 
 	glTexParameteri(texture_type, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 	glTexParameteri(texture_type, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
@@ -17,27 +68,30 @@ Texture::Texture(const char* image, GLenum texture_type, GLenum slot, GLenum for
 	glTexParameteri(texture_type, GL_TEXTURE_WRAP_S, GL_REPEAT);
 	glTexParameteri(texture_type, GL_TEXTURE_WRAP_T, GL_REPEAT);
 
-	glTexImage2D(texture_type, 0, GL_RGB, width_img, height_img, 0, format, pixel_type, bytes);
+	// Immutable storage in the sized format matching the decoded channels
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	glTexStorage2D(texture_type, textureLevels(width_img, height_img), textureInternalFormat(channels), width_img, height_img);
+	glTexSubImage2D(texture_type, 0, 0, 0, width_img, height_img, format, pixel_type, bytes);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
 	glGenerateMipmap(texture_type);
 
 	stbi_image_free(bytes);
-	glBindTexture(texture_type, 0);
+	GLState::BindTexture(texture_type, 0);
 }
 
 void Texture::textureUnit(Shader& shader, const char* uniform, GLuint unit) {
-	GLuint textureUni = glGetUniformLocation(shader.ID, uniform);
-	shader.Activate();
-	glUniform1i(textureUni, unit);
+	shader.setInt(shader.uniformLocation(uniform), unit);
 }
 
 void Texture::Bind() {
-	glBindTexture(type, ID);
+	GLState::BindTexture(type, ID);
 }
 
 void Texture::Unbind() {
-	glBindTexture(type, 0);
+	GLState::BindTexture(type, 0);
 }
 
 void Texture::Delete() {
+	GLState::ForgetTexture(ID);
 	glDeleteTextures(1, &ID);
 }
\ No newline at end of file
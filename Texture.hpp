@@ -5,11 +5,21 @@
 
 #include "ShaderClass.hpp"
 
+// Sized internal format and pixel format for 1 to 4 channel 8 bit images
+GLenum textureInternalFormat(int channels);
+GLenum textureFormat(int channels);
+// Channels of a pixel format, the inverse of textureFormat
+int textureChannels(GLenum format);
+// Mip levels down to 1x1
+GLsizei textureLevels(int width, int height);
+
 class Texture {
 public:
 	GLuint ID;
 	GLenum type;
 
+	// Empty, ID stays 0 until something (e.g. TextureLoader) fills it in
+	Texture();
 	Texture(const char* image, GLenum texture_type, GLenum slot, GLenum format, GLenum pixel_type);
 
 	void textureUnit(Shader& shader, const char* uniform, GLuint unit);
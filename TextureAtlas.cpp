@@ -0,0 +1,154 @@
+#include "TextureAtlas.hpp"
+
+#include <algorithm>
+#include <iostream>
+
+#include "GLState.hpp"
+#include "BakedTexture.hpp"
+
+// Baked skins are copied in straight from their mapping, no decoding at all
+static bool isBaked(const std::string& image) {
+	return image.size() > 5 && image.compare(image.size() - 5, 5, ".ptex") == 0;
+}
+
+// Baked image the atlas can hold, false (error printed) for anything but RGBA8
+static bool openBakedSkin(const std::string& image, MappedFile& file, BakedTextureHeader& header, const BakedTextureLevel*& levels) {
+	if (!openBakedTexture(image.c_str(), file, header, levels)) {
+		return false;
+	}
+
+	if (header.compressed_format != 0 || header.channels != 4) {
+		std::cout << "ERROR::TEXTURE::ATLAS_NEEDS_RGBA8 " << image << std::endl;
+		return false;
+	}
+
+	return true;
+}
+
+TextureAtlas::TextureAtlas(int layer_width, int layer_height)
+	: layer_width(layer_width), layer_height(layer_height) {
+	texture.type = GL_TEXTURE_2D_ARRAY;
+}
+
+unsigned int TextureAtlas::Add(const std::string& image) {
+	images.push_back(image);
+	return (unsigned int)images.size() - 1;
+}
+
+bool TextureAtlas::Build(TextureLoader* loader) {
+	std::vector<AtlasRect> rects(images.size());
+	std::vector<bool> placed(images.size(), false);
+	bool ok = true;
+
+	// Baked images stay mapped until their pixels are copied below
+	std::vector<MappedFile> baked_files(images.size());
+	std::vector<const BakedTextureLevel*> baked_levels(images.size(), NULL);
+
+	// Only the headers are read here, decoding happens below or on the loader's workers
+	for (std::size_t i = 0; i < images.size(); i++) {
+		int channels;
+
+		if (isBaked(images[i])) {
+			BakedTextureHeader header;
+
+			bool baked = openBakedSkin(images[i], baked_files[i], header, baked_levels[i]);
+			rects[i].width = baked ? (int)header.width : 0;
+			rects[i].height = baked ? (int)header.height : 0;
+			ok = ok && baked;
+		}
+		else if (!stbi_info(images[i].c_str(), &rects[i].width, &rects[i].height, &channels)) {
+			std::cout << "ERROR::TEXTURE::LOADING_FAILED " << images[i] << "\n" << stbi_failure_reason() << std::endl;
+			rects[i].width = 0;
+			rects[i].height = 0;
+			ok = false;
+		}
+	}
+
+	// Tallest first
+	std::vector<std::size_t> order(images.size());
+	for (std::size_t i = 0; i < order.size(); i++) order[i] = i;
+	std::stable_sort(order.begin(), order.end(), [&rects](std::size_t a, std::size_t b) {
+		return rects[a].height > rects[b].height;
+	});
+
+	AtlasPacker packer(layer_width, layer_height);
+
+	for (std::size_t i : order) {
+		if (rects[i].width == 0) {
+			continue;
+		}
+
+		placed[i] = packer.Pack(rects[i].width, rects[i].height, rects[i]);
+
+		if (!placed[i]) {
+			std::cout << "ERROR::TEXTURE::ATLAS_TOO_SMALL " << images[i] << std::endl;
+			ok = false;
+		}
+	}
+
+	Delete();
+
+	glCreateTextures(GL_TEXTURE_2D_ARRAY, 1, &texture.ID);
+	glTextureStorage3D(texture.ID, 1, GL_RGBA8, layer_width, layer_height, std::max(packer.layers, 1));
+
+	glTextureParameteri(texture.ID, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+	glTextureParameteri(texture.ID, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+	glTextureParameteri(texture.ID, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+	glTextureParameteri(texture.ID, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+
+	// Transparent until each image arrives
+	const unsigned char clear[4] = { 0, 0, 0, 0 };
+	glClearTexImage(texture.ID, 0, GL_RGBA, GL_UNSIGNED_BYTE, clear);
+
+	entries.assign(images.size(), AtlasEntry { glm::vec4(0.0f), instance_untextured });
+
+	for (std::size_t i = 0; i < images.size(); i++) {
+		if (!placed[i]) {
+			continue;
+		}
+
+		const AtlasRect& rect = rects[i];
+
+		entries[i].uv = glm::vec4(
+			(float)rect.x / layer_width, (float)rect.y / layer_height,
+			(float)(rect.x + rect.width) / layer_width, (float)(rect.y + rect.height) / layer_height);
+		entries[i].layer = rect.layer;
+
+		// The atlas has a single level, so only level 0 of a baked mip chain is used
+		if (baked_levels[i]) {
+			glTextureSubImage3D(texture.ID, 0, rect.x, rect.y, rect.layer, rect.width, rect.height, 1,
+				GL_RGBA, GL_UNSIGNED_BYTE, baked_files[i].data + baked_levels[i][0].offset);
+			continue;
+		}
+
+		if (loader) {
+			loader->LoadRegion(images[i], texture.ID, rect.layer, rect.x, rect.y, rect.width, rect.height);
+			continue;
+		}
+
+		// Always 4 channels, every layer shares one RGBA8 format
+		int width, height, channels;
+		stbi_set_flip_vertically_on_load(true);
+		unsigned char* pixels = stbi_load(images[i].c_str(), &width, &height, &channels, 4);
+
+		if (!pixels || width != rect.width || height != rect.height) {
+			std::cout << "ERROR::TEXTURE::LOADING_FAILED " << images[i] << std::endl;
+			if (pixels) stbi_image_free(pixels);
+			entries[i].layer = instance_untextured;
+			ok = false;
+			continue;
+		}
+
+		glTextureSubImage3D(texture.ID, 0, rect.x, rect.y, rect.layer, rect.width, rect.height, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+		stbi_image_free(pixels);
+	}
+
+	return ok;
+}
+
+void TextureAtlas::Delete() {
+	if (texture.ID != 0) {
+		texture.Delete();
+		texture.ID = 0;
+	}
+}
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include <glad/glad.h>
+#include <glm/glm.hpp>
+
+#include "AtlasPacker.hpp"
+#include "Texture.hpp"
+#include "Instance.hpp"
+#include "TextureLoader.hpp"
+
+// Image placed in the atlas, uv is (u0, v0, u1, v1) inside layer. Images that failed
+// keep layer instance_untextured and draw with their color only
+struct AtlasEntry {
+	glm::vec4 uv;
+	unsigned int layer;
+};
+
+// Packs many images into the layers of one GL_TEXTURE_2D_ARRAY, so every skin and sprite
+// is drawn with the same binding. Sprites pick theirs through per-instance uv and layer
+class TextureAtlas {
+	public:
+		Texture texture;
+		std::vector<AtlasEntry> entries;
+
+		TextureAtlas(int layer_width = 2048, int layer_height = 2048);
+
+		// Queues an image, returns the index its entry will have after Build. A .ptex baked
+		// as RGBA8 is copied straight from its mapping, anything else goes through stb
+		unsigned int Add(const std::string& image);
+
+		// Packs everything queued from the image headers and allocates the layers, false if an
+		// image couldn't be read or didn't fit. Pixels are decoded and uploaded right away, or
+		// by loader over the next frames (entries are valid at once, pixels stay transparent
+		// until loader.Pending() drops to 0)
+		bool Build(TextureLoader* loader = NULL);
+
+		void Delete();
+
+	private:
+		int layer_width, layer_height;
+		std::vector<std::string> images;
+};
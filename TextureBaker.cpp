@@ -0,0 +1,102 @@
+#include "TextureBaker.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <vector>
+
+#include <stb/stb_image.h>
+
+#include "BakedTextureFormat.hpp"
+
+std::vector<unsigned char> downsampleLevel(const std::vector<unsigned char>& source, int width, int height, int channels) {
+	int next_width = std::max(width / 2, 1);
+	int next_height = std::max(height / 2, 1);
+
+	std::vector<unsigned char> level((std::size_t)next_width * next_height * channels);
+
+	for (int y = 0; y < next_height; y++) {
+		int y0 = std::min(y * 2, height - 1), y1 = std::min(y * 2 + 1, height - 1);
+
+		for (int x = 0; x < next_width; x++) {
+			int x0 = std::min(x * 2, width - 1), x1 = std::min(x * 2 + 1, width - 1);
+
+			for (int c = 0; c < channels; c++) {
+				int sum = source[((std::size_t)y0 * width + x0) * channels + c] + source[((std::size_t)y0 * width + x1) * channels + c]
+					+ source[((std::size_t)y1 * width + x0) * channels + c] + source[((std::size_t)y1 * width + x1) * channels + c];
+
+				level[((std::size_t)y * next_width + x) * channels + c] = (unsigned char)((sum + 2) / 4);
+			}
+		}
+	}
+
+	return level;
+}
+
+bool bakeTexture(const char* image, const char* output) {
+	int width, height, channels;
+
+	// Same orientation as Texture loads source images in
+	stbi_set_flip_vertically_on_load(true);
+	unsigned char* bytes = stbi_load(image, &width, &height, &channels, 0);
+
+	if (!bytes) {
+		std::cout << "ERROR::TEXTURE::LOADING_FAILED " << image << "\n" << stbi_failure_reason() << std::endl;
+		return false;
+	}
+
+	std::vector<std::vector<unsigned char>> levels;
+	std::vector<BakedTextureLevel> table;
+
+	levels.push_back(std::vector<unsigned char>(bytes, bytes + (std::size_t)width * height * channels));
+	stbi_image_free(bytes);
+
+	int level_width = width, level_height = height;
+	table.push_back(BakedTextureLevel { 0, levels.back().size(), (uint32_t)level_width, (uint32_t)level_height });
+
+	while (level_width > 1 || level_height > 1) {
+		levels.push_back(downsampleLevel(levels.back(), level_width, level_height, channels));
+
+		level_width = std::max(level_width / 2, 1);
+		level_height = std::max(level_height / 2, 1);
+		table.push_back(BakedTextureLevel { 0, levels.back().size(), (uint32_t)level_width, (uint32_t)level_height });
+	}
+
+	BakedTextureHeader header = {};
+	std::copy(baked_texture_magic, baked_texture_magic + 4, header.magic);
+	header.version = baked_texture_version;
+	header.width = width;
+	header.height = height;
+	header.channels = channels;
+	header.levels = (uint32_t)levels.size();
+	header.compressed_format = 0;
+
+	// Lays the levels out after the table, each on an aligned offset
+	uint64_t offset = sizeof(header) + table.size() * sizeof(BakedTextureLevel);
+
+	for (BakedTextureLevel& level : table) {
+		offset = (offset + baked_texture_alignment - 1) / baked_texture_alignment * baked_texture_alignment;
+		level.offset = offset;
+		offset += level.size;
+	}
+
+	std::ofstream file(output, std::ios::binary | std::ios::trunc);
+	file.write((const char*)&header, sizeof(header));
+	file.write((const char*)table.data(), table.size() * sizeof(BakedTextureLevel));
+
+	for (std::size_t i = 0; i < levels.size(); i++) {
+		// Pads up to the level's offset
+		std::vector<char> padding((std::size_t)(table[i].offset - (uint64_t)file.tellp()), 0);
+		file.write(padding.data(), padding.size());
+		file.write((const char*)levels[i].data(), levels[i].size());
+	}
+
+	if (!file) {
+		std::cout << "ERROR::TEXTURE::BAKING_FAILED " << output << std::endl;
+		return false;
+	}
+
+	std::cout << "Baked " << image << " (" << width << "x" << height << ", " << channels << " channels, "
+		<< levels.size() << " levels) into " << output << std::endl;
+	return true;
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <vector>
+
+// Offline side of BakedTexture: decodes image, builds the full mip chain on the CPU with a
+// box filter and writes it as a .ptex container. Needs no GL context
+bool bakeTexture(const char* image, const char* output);
+
+// Next mip level of a tightly packed 8 bit image, every texel averages the 2x2 block under
+// it (clamped at odd edges). Also used by TextureLoader's workers
+std::vector<unsigned char> downsampleLevel(const std::vector<unsigned char>& source, int width, int height, int channels);
@@ -0,0 +1,192 @@
+#include "TextureLoader.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <iterator>
+
+#include "GLState.hpp"
+#include "TextureBaker.hpp"
+
+static std::size_t decodedBytes(const std::vector<std::vector<unsigned char>>& levels) {
+	std::size_t bytes = 0;
+
+	for (const std::vector<unsigned char>& level : levels) {
+		bytes += level.size();
+	}
+
+	return bytes;
+}
+
+TextureLoader::TextureLoader(WorkStealingPool& pool, std::size_t upload_budget)
+	: upload_budget(upload_budget), pool(pool), staging(upload_budget, BUFFER_PERSISTENT), pending(0) {
+}
+
+TextureLoader::~TextureLoader() {
+	pool.Wait();
+}
+
+void TextureLoader::Load(const std::string& image, Texture* texture) {
+	Decoded request = { image, std::string(), texture, 0, -1, 0, 0, 0, 0, 0, {} };
+	submit(request, true);
+}
+
+void TextureLoader::LoadRegion(const std::string& image, GLuint array_texture, int layer, int x, int y, int width, int height) {
+	Decoded request = { image, std::string(), NULL, array_texture, layer, x, y, width, height, 4, {} };
+	submit(request, false);
+}
+
+void TextureLoader::submit(Decoded request, bool mipmaps) {
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		pending++;
+	}
+
+	pool.Submit([this, request, mipmaps]() {
+		Decoded result = request;
+
+		// Flip setting is per thread, workers never share stb state
+		int width, height, channels;
+		stbi_set_flip_vertically_on_load_thread(true);
+		unsigned char* pixels = stbi_load(result.image.c_str(), &width, &height, &channels, result.texture ? 0 : 4);
+
+		if (!pixels) {
+			const char* reason = stbi_failure_reason();
+			result.error = reason ? reason : "unknown error";
+		}
+		else if (!result.texture && (width != result.width || height != result.height)) {
+			result.error = "image size differs from its atlas region";
+			stbi_image_free(pixels);
+		}
+		else {
+			if (result.texture) {
+				result.width = width;
+				result.height = height;
+				result.channels = channels;
+			}
+
+			result.levels.push_back(std::vector<unsigned char>(pixels, pixels + (std::size_t)width * height * result.channels));
+			stbi_image_free(pixels);
+
+			// Mips are built here too, the GL thread only copies
+			for (int w = width, h = height; mipmaps && (w > 1 || h > 1); w = std::max(w / 2, 1), h = std::max(h / 2, 1)) {
+				result.levels.push_back(downsampleLevel(result.levels.back(), w, h, result.channels));
+			}
+		}
+
+		std::lock_guard<std::mutex> lock(mutex);
+		decoded.push_back(std::move(result));
+	});
+}
+
+unsigned int TextureLoader::Update() {
+	std::vector<Decoded> ready;
+
+	// Takes as many decoded images as fit in this frame's budget, at least one
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		std::size_t bytes = 0;
+		std::size_t taken = 0;
+
+		while (taken < decoded.size() && (taken == 0 || bytes + decodedBytes(decoded[taken].levels) <= upload_budget)) {
+			bytes += decodedBytes(decoded[taken].levels);
+			taken++;
+		}
+
+		std::move(decoded.begin(), decoded.begin() + taken, std::back_inserter(ready));
+		decoded.erase(decoded.begin(), decoded.begin() + taken);
+		pending -= taken;
+	}
+
+	if (ready.empty()) {
+		return 0;
+	}
+
+	// Next region of the ring, waits only if the GPU still reads it from three updates ago
+	unsigned char* region = staging.Next();
+	std::size_t used = 0;
+
+	// Rows of 1 and 3 channel images and of small mips aren't 4 byte aligned
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+	GLState::BindBuffer(GL_PIXEL_UNPACK_BUFFER, staging.ID);
+
+	for (const Decoded& image : ready) {
+		upload(image, region, staging.Offset(), used);
+	}
+
+	GLState::BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+
+	// The copies out of the region run asynchronously, it is reused once they're done
+	staging.Fence();
+
+	return (unsigned int)ready.size();
+}
+
+std::size_t TextureLoader::Pending() const {
+	std::lock_guard<std::mutex> lock(mutex);
+	return pending;
+}
+
+void TextureLoader::Delete() {
+	staging.Delete();
+}
+
+void TextureLoader::upload(const Decoded& image, unsigned char* region, GLintptr region_offset, std::size_t& used) {
+	if (image.levels.empty()) {
+		std::cout << "ERROR::TEXTURE::LOADING_FAILED " << image.image << "\n" << image.error << std::endl;
+		return;
+	}
+
+	// Only an image larger than the whole budget misses the ring, it goes straight from memory
+	std::size_t bytes = decodedBytes(image.levels);
+	bool staged = used + bytes <= upload_budget;
+
+	if (!staged) {
+		GLState::BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+	}
+
+	GLuint texture = image.array_texture;
+
+	if (image.texture) {
+		glCreateTextures(GL_TEXTURE_2D, 1, &texture);
+		glTextureStorage2D(texture, (GLsizei)image.levels.size(), textureInternalFormat(image.channels), image.width, image.height);
+
+		glTextureParameteri(texture, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+		glTextureParameteri(texture, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+		glTextureParameteri(texture, GL_TEXTURE_WRAP_S, GL_REPEAT);
+		glTextureParameteri(texture, GL_TEXTURE_WRAP_T, GL_REPEAT);
+	}
+
+	int width = image.width, height = image.height;
+
+	for (std::size_t level = 0; level < image.levels.size(); level++) {
+		const void* pixels = image.levels[level].data();
+
+		if (staged) {
+			std::memcpy(region + used, pixels, image.levels[level].size());
+			pixels = (const void*)(region_offset + used);
+			used += image.levels[level].size();
+		}
+
+		if (image.texture) {
+			glTextureSubImage2D(texture, (GLint)level, 0, 0, width, height, textureFormat(image.channels), GL_UNSIGNED_BYTE, pixels);
+		}
+		else {
+			glTextureSubImage3D(texture, 0, image.x, image.y, image.layer, width, height, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+		}
+
+		width = std::max(width / 2, 1);
+		height = std::max(height / 2, 1);
+	}
+
+	if (!staged) {
+		GLState::BindBuffer(GL_PIXEL_UNPACK_BUFFER, staging.ID);
+	}
+
+	if (image.texture) {
+		image.texture->ID = texture;
+		image.texture->type = GL_TEXTURE_2D;
+	}
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <glad/glad.h>
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "Texture.hpp"
+#include "ThreadPool.hpp"
+#include "GpuBuffer.hpp"
+
+// Decodes images and builds their mip chains on a thread pool, then uploads them from the
+// GL thread through a persistently mapped ring of pixel unpack buffers, a limited number of
+// bytes per frame so loading a pack never hitches a frame. Create and use on the GL thread
+class TextureLoader {
+	public:
+		// Bytes copied into the staging ring per Update, also the size of each ring region
+		std::size_t upload_budget;
+
+		TextureLoader(WorkStealingPool& pool, std::size_t upload_budget = 4 << 20);
+		// Waits for the pool, decoded images that never got uploaded are dropped
+		~TextureLoader();
+
+		// Queues image for decoding, texture keeps ID 0 until Update has uploaded it and
+		// has to stay alive until then
+		void Load(const std::string& image, Texture* texture);
+
+		// Queues image for decoding as RGBA8 into the width by height region at (x, y) of
+		// layer of an existing array texture (e.g. TextureAtlas), only level 0 is written
+		void LoadRegion(const std::string& image, GLuint array_texture, int layer, int x, int y, int width, int height);
+
+		// Call once per frame on the GL thread, returns the number of textures finished
+		unsigned int Update();
+
+		// Images queued or decoded but not uploaded yet
+		std::size_t Pending() const;
+
+		// Frees the staging ring, call before the context goes away
+		void Delete();
+
+	private:
+		struct Decoded {
+			std::string image;
+			// stb keeps its failure reason per thread, so the worker copies it here
+			std::string error;
+
+			// Own texture to create, or an array texture region to fill (texture NULL)
+			Texture* texture;
+			GLuint array_texture;
+			int layer, x, y;
+
+			int width, height, channels;
+			// Level 0 first, empty when decoding failed
+			std::vector<std::vector<unsigned char>> levels;
+		};
+
+		WorkStealingPool& pool;
+		GpuBuffer<unsigned char> staging;
+
+		mutable std::mutex mutex;
+		std::vector<Decoded> decoded;
+		std::size_t pending;
+
+		void submit(Decoded request, bool mipmaps);
+		// Copies into the current staging region at used when it fits, straight from memory otherwise
+		void upload(const Decoded& image, unsigned char* region, GLintptr region_offset, std::size_t& used);
+};
@@ -0,0 +1,154 @@
+#include "ThreadPool.hpp"
+
+#include <chrono>
+
+// Worker the current thread belongs to, -1 outside the pool
+static thread_local int current_worker = -1;
+static thread_local WorkStealingPool* current_pool = nullptr;
+static thread_local WorkStealingPool::WorkerStats* current_stats = nullptr;
+
+WorkStealingPool::WorkStealingPool(unsigned int threads) : queued(0), pending(0), next_queue(0), stop(false) {
+	if (threads == 0) {
+		threads = 1;
+	}
+
+	for (unsigned int i = 0; i < threads; i++) {
+		queues.emplace_back(new WorkerQueue());
+		stats.emplace_back(new WorkerStats());
+	}
+
+	ResetStats();
+
+	for (unsigned int i = 0; i < threads; i++) {
+		workers.emplace_back(&WorkStealingPool::workerLoop, this, i);
+	}
+}
+
+WorkStealingPool::~WorkStealingPool() {
+	{
+		std::lock_guard<std::mutex> lock(sleep_mutex);
+		stop = true;
+	}
+	work_available.notify_all();
+
+	for (std::thread& worker : workers) {
+		worker.join();
+	}
+}
+
+void WorkStealingPool::Submit(Task task) {
+	// Tasks spawned by a worker go to its own queue so they stay cache warm
+	unsigned int index = (current_pool == this) ? (unsigned int)current_worker : next_queue++ % Size();
+
+	pending++;
+	{
+		std::lock_guard<std::mutex> lock(queues[index]->mutex);
+		queues[index]->tasks.push_back(std::move(task));
+	}
+	queued++;
+
+	{
+		std::lock_guard<std::mutex> lock(sleep_mutex);
+	}
+	work_available.notify_one();
+}
+
+void WorkStealingPool::Wait() {
+	std::unique_lock<std::mutex> lock(sleep_mutex);
+	all_done.wait(lock, [this] { return pending == 0; });
+}
+
+unsigned int WorkStealingPool::Size() const {
+	return (unsigned int)workers.size();
+}
+
+const WorkStealingPool::WorkerStats& WorkStealingPool::Stats(unsigned int worker) const {
+	return *stats[worker];
+}
+
+void WorkStealingPool::ResetStats() {
+	for (std::unique_ptr<WorkerStats>& worker_stats : stats) {
+		worker_stats->tasks = 0;
+		worker_stats->steals = 0;
+		worker_stats->work_units = 0;
+		worker_stats->busy_ns = 0;
+	}
+}
+
+void WorkStealingPool::AddWork(unsigned long long units) {
+	if (current_stats) {
+		current_stats->work_units.fetch_add(units, std::memory_order_relaxed);
+	}
+}
+
+void WorkStealingPool::workerLoop(unsigned int index) {
+	current_worker = (int)index;
+	current_pool = this;
+	current_stats = stats[index].get();
+
+	WorkerStats& worker_stats = *stats[index];
+
+	while (true) {
+		Task task;
+		bool stolen = false;
+
+		if (!popTask(index, task)) {
+			stolen = stealTask(index, task);
+
+			if (!stolen) {
+				std::unique_lock<std::mutex> lock(sleep_mutex);
+				work_available.wait(lock, [this] { return stop || queued > 0; });
+
+				if (stop && queued == 0) {
+					return;
+				}
+				continue;
+			}
+		}
+
+		queued--;
+
+		auto start = std::chrono::steady_clock::now();
+		task();
+		auto busy = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+		worker_stats.tasks.fetch_add(1, std::memory_order_relaxed);
+		worker_stats.steals.fetch_add(stolen ? 1 : 0, std::memory_order_relaxed);
+		worker_stats.busy_ns.fetch_add((unsigned long long)busy, std::memory_order_relaxed);
+
+		if (--pending == 0) {
+			std::lock_guard<std::mutex> lock(sleep_mutex);
+			all_done.notify_all();
+		}
+	}
+}
+
+// Owner takes the newest task
+bool WorkStealingPool::popTask(unsigned int index, Task& task) {
+	WorkerQueue& queue = *queues[index];
+	std::lock_guard<std::mutex> lock(queue.mutex);
+
+	if (queue.tasks.empty()) {
+		return false;
+	}
+
+	task = std::move(queue.tasks.back());
+	queue.tasks.pop_back();
+	return true;
+}
+
+// Thieves take the oldest task, starting from the next worker over
+bool WorkStealingPool::stealTask(unsigned int index, Task& task) {
+	for (unsigned int offset = 1; offset < Size(); offset++) {
+		WorkerQueue& queue = *queues[(index + offset) % Size()];
+		std::lock_guard<std::mutex> lock(queue.mutex);
+
+		if (!queue.tasks.empty()) {
+			task = std::move(queue.tasks.front());
+			queue.tasks.pop_front();
+			return true;
+		}
+	}
+
+	return false;
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+const std::size_t cache_line_size = 64;
+
+// Work stealing thread pool, every worker owns a queue and takes from its back,
+// idle workers steal from the front of the others
+class WorkStealingPool {
+	public:
+		typedef std::function<void()> Task;
+
+		// Per worker counters, the trailing padding keeps neighbouring workers off each
+		// other's cache lines without relying on over-aligned new (C++17)
+		struct WorkerStats {
+			std::atomic<unsigned long long> tasks;
+			std::atomic<unsigned long long> steals;
+			std::atomic<unsigned long long> work_units;
+			std::atomic<unsigned long long> busy_ns;
+			char padding[cache_line_size];
+		};
+
+		explicit WorkStealingPool(unsigned int threads = std::thread::hardware_concurrency());
+		~WorkStealingPool();
+
+		WorkStealingPool(const WorkStealingPool&) = delete;
+		WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+		// Queues a task, tasks submitted from a worker stay on that worker
+		void Submit(Task task);
+		// Blocks until every submitted task has finished
+		void Wait();
+
+		unsigned int Size() const;
+		const WorkerStats& Stats(unsigned int worker) const;
+		void ResetStats();
+
+		// Adds units of work (e.g. match ticks) to the calling worker's counters
+		static void AddWork(unsigned long long units);
+
+	private:
+		struct WorkerQueue {
+			std::mutex mutex;
+			std::deque<Task> tasks;
+			char padding[cache_line_size];
+		};
+
+		std::vector<std::unique_ptr<WorkerQueue>> queues;
+		std::vector<std::unique_ptr<WorkerStats>> stats;
+		std::vector<std::thread> workers;
+
+		std::atomic<long long> queued;
+		std::atomic<long long> pending;
+		std::atomic<unsigned int> next_queue;
+		bool stop;
+
+		std::mutex sleep_mutex;
+		std::condition_variable work_available;
+		std::condition_variable all_done;
+
+		void workerLoop(unsigned int index);
+		bool popTask(unsigned int index, Task& task);
+		bool stealTask(unsigned int index, Task& task);
+};
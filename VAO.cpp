@@ -1,30 +1,43 @@
 #include "VAO.hpp"
 
+#include "GLState.hpp"
+
+// Direct state access, nothing is bound while the VAO is set up. Every attribute uses
+// the buffer binding point of the same index as its layout
+
 VAO::VAO() {
-	glGenVertexArrays(1, &ID);
+	glCreateVertexArrays(1, &ID);
 }
 
-// Link passed VBO to the current VAO object
-void VAO::linkAttrib(VBO& VBO, GLuint layout, GLuint numComponents, GLenum type, GLsizei stride, void* offset, GLuint divisor) {
-	VBO.Bind();
-	glVertexAttribPointer(layout, numComponents, type, GL_FALSE, stride, offset);
-	glEnableVertexAttribArray(layout);
+// Link passed buffer to the current VAO object
+void VAO::linkAttrib(GLuint buffer, GLuint layout, GLuint numComponents, GLenum type, GLsizei stride, void* offset, GLuint divisor) {
+	glVertexArrayVertexBuffer(ID, layout, buffer, (GLintptr)offset, stride);
+	glVertexArrayAttribFormat(ID, layout, numComponents, type, GL_FALSE, 0);
+	glVertexArrayAttribBinding(ID, layout, layout);
+	glEnableVertexArrayAttrib(ID, layout);
 
 	if (divisor > 0) {
-		glVertexAttribDivisor(layout, divisor);
+		glVertexArrayBindingDivisor(ID, layout, divisor);
 	}
+}
 
-	VBO.Unbind();
+void VAO::linkBuffer(GLuint buffer, GLuint layout, GLsizei stride, GLintptr offset) {
+	glVertexArrayVertexBuffer(ID, layout, buffer, offset, stride);
+}
+
+void VAO::linkElements(EBO& EBO) {
+	glVertexArrayElementBuffer(ID, EBO.ID);
 }
 
 void VAO::Bind() {
-	glBindVertexArray(ID);
+	GLState::BindVertexArray(ID);
 }
 
 void VAO::Unbind() {
-	glBindVertexArray(0);
+	GLState::BindVertexArray(0);
 }
 
 void VAO::Delete() {
+	GLState::ForgetVertexArray(ID);
 	glDeleteVertexArrays(1, &ID);
-}
\ No newline at end of file
+}
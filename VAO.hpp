@@ -1,17 +1,32 @@
 #pragma once
 
 #include <glad/glad.h>
-#include "VBO.hpp"
+#include "GpuBuffer.hpp"
+#include "EBO.hpp"
 
 class VAO {
 	public: 
 		GLuint ID;
 		VAO();
 
-		// Link passed VBO to the current VAO object
-		void linkAttrib(VBO& VBO, GLuint layout, GLuint numComponents, GLenum type, GLsizei stride, void* offset, GLuint divisor);
+		// Link passed buffer to the current VAO object
+		void linkAttrib(GLuint buffer, GLuint layout, GLuint numComponents, GLenum type, GLsizei stride, void* offset, GLuint divisor);
+		// Points an already linked attribute at another part of a buffer, format stays the same
+		void linkBuffer(GLuint buffer, GLuint layout, GLsizei stride, GLintptr offset);
+		// Link passed EBO as the VAO's index buffer
+		void linkElements(EBO& EBO);
+
+		template <typename T>
+		void linkAttrib(GpuBuffer<T>& buffer, GLuint layout, GLuint numComponents, GLenum type, GLsizei stride, void* offset, GLuint divisor) {
+			linkAttrib(buffer.ID, layout, numComponents, type, stride, offset, divisor);
+		}
+
+		template <typename T>
+		void linkBuffer(GpuBuffer<T>& buffer, GLuint layout, GLsizei stride, GLintptr offset) {
+			linkBuffer(buffer.ID, layout, stride, offset);
+		}
 
 		void Bind();
 		void Unbind();
 		void Delete();
-};
\ No newline at end of file
+};
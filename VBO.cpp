@@ -1,27 +0,0 @@
-#include "VBO.hpp"
-
-VBO::VBO(glm::vec2* verticies, GLsizeiptr size, GLenum draw) {
-	glGenBuffers(1, &ID);
-
-	glBindBuffer(GL_ARRAY_BUFFER, ID);
-	glBufferData(GL_ARRAY_BUFFER, size, verticies, draw);
-}
-
-VBO::VBO(GLfloat* verticies, GLsizeiptr size, GLenum draw) {
-	glGenBuffers(1, &ID);
-
-	glBindBuffer(GL_ARRAY_BUFFER, ID);
-	glBufferData(GL_ARRAY_BUFFER, size, verticies, draw);
-}
-
-void VBO::Bind() {
-	glBindBuffer(GL_ARRAY_BUFFER, ID);
-}
-
-void VBO::Unbind() {
-	glBindBuffer(GL_ARRAY_BUFFER, 0);
-}
-
-void VBO::Delete() {
-	glDeleteBuffers(1, &ID);
-}
\ No newline at end of file
@@ -1,7 +1,32 @@
 #version 460 core
 
+in vec2 local;
+flat in vec2 half_size;
+flat in float circle;
+flat in vec3 tint;
+flat in vec4 uv_rect;
+flat in float layer;
+
+// Every skin and sprite image, packed by TextureAtlas
+uniform sampler2DArray atlas;
+
 out vec4 color;
 
 void main() {
-	color = vec4(1.0);
-}
\ No newline at end of file
+	// Signed distance to the edge, negative inside, for a box and for a circle
+	vec2 box = abs(local) - half_size;
+	float box_distance = length(max(box, 0.0)) + min(max(box.x, box.y), 0.0);
+	float circle_distance = length(local) - half_size.x;
+
+	float edge_distance = mix(box_distance, circle_distance, circle);
+
+	// Coverage of the pixel, a one pixel wide ramp across the edge
+	float coverage = clamp(0.5 - edge_distance / max(fwidth(edge_distance), 1e-4), 0.0, 1.0);
+
+	// Sampled outside the branch so derivatives stay defined, untextured shapes ignore it
+	vec2 uv = mix(uv_rect.xy, uv_rect.zw, clamp(local / (2.0 * half_size) + 0.5, 0.0, 1.0));
+	vec4 texel = texture(atlas, vec3(uv, max(layer, 0.0)));
+	if (layer < 0.0) texel = vec4(1.0);
+
+	color = vec4(tint, coverage) * texel;
+}
@@ -1,11 +1,50 @@
 #version 460 core
 
 layout (location = 0) in vec2 pos;
-layout (location = 1) in vec2 offset;
-layout (location = 2) in vec2 size;
+
+// Must match PackedInstance
+struct Instance {
+	vec2 offset;
+	uint size;
+	uint color_shape;
+	uint uv_min;
+	uint uv_max;
+	uint layer;
+	uint padding;
+};
+
+layout (std430, binding = 0) readonly buffer Instances {
+	Instance instances[];
+};
 
 uniform mat4 projection;
 
+// Fragment position relative to the shape's center, in pixels
+out vec2 local;
+flat out vec2 half_size;
+flat out float circle;
+flat out vec3 tint;
+flat out vec4 uv_rect;
+flat out float layer;
+
+// Room around the shape for the anti-aliased edge
+const float edge = 1.0;
+
+const uint SHAPE_CIRCLE = 1u;
+const uint UNTEXTURED = 0xFFFFFFFFu;
+
 void main() {
-   gl_Position = projection * vec4((pos * size) + offset, 0.0, 1.0);
-}
\ No newline at end of file
+   // Draw commands pick their instances through base_instance
+   Instance instance = instances[gl_BaseInstance + gl_InstanceID];
+   vec2 size = unpackHalf2x16(instance.size);
+
+   // Zero sized instances are unused slots, every corner collapses onto the center
+   local = (size.x > 0.0 && size.y > 0.0) ? pos * (size + 2.0 * edge) : vec2(0.0);
+   half_size = size * 0.5;
+   circle = (instance.color_shape >> 24) == SHAPE_CIRCLE ? 1.0 : 0.0;
+   tint = unpackUnorm4x8(instance.color_shape).rgb;
+   uv_rect = vec4(unpackUnorm2x16(instance.uv_min), unpackUnorm2x16(instance.uv_max));
+   layer = instance.layer == UNTEXTURED ? -1.0 : float(instance.layer);
+
+   gl_Position = projection * vec4(local + instance.offset, 0.0, 1.0);
+}
@@ -1,4 +1,7 @@
 #include <iostream>
+#include <fstream>
+#include <ctime>
+#include <string>
 
 #include <glad/glad.h>
 #include <GLFW/glfw3.h>
@@ -7,75 +10,39 @@
 #include <glm/gtc/type_ptr.hpp>	
 
 #include "ShaderClass.hpp"
-#include "VBO.hpp"
+#include "GLState.hpp"
+#include "GpuBuffer.hpp"
+#include "BufferBenchmark.hpp"
+#include "SpriteBenchmark.hpp"
+#include "ReadbackBenchmark.hpp"
 #include "VAO.hpp"
 #include "EBO.hpp"
+#include "IndirectBuffer.hpp"
+#include "Instance.hpp"
+#include "Quad.hpp"
+#include "TextRenderer.hpp"
+#include "TextureAtlas.hpp"
+#include "TextureLoader.hpp"
+#include "ThreadPool.hpp"
+#include "Game.hpp"
+#include "FixedTimestep.hpp"
 
 GLuint SCREEN_WIDTH = 800;
 GLuint SCREEN_HEIGHT = 600;
 Shader SHADER;
+// Looked up once the program has linked, -1 until then
+GLint PROJECTION_LOCATION = -1;
 
-const float PI = 4 * atanf(1.0f);
+// Simulation rate, independent from the display refresh rate
+const uint64_t SIMULATION_TICK_NS = 1000000000ull / 120;
 
-const float ball_diameter = 14.0f;
-const float ball_radius = ball_diameter / 2.0f;
+// Frames wait for one vertical sync, benchmarks turn it off while they run and put this back
+const int SWAP_INTERVAL = 1;
 
-const float paddle_height = 80.0f;
-const float paddle_width = 12.0f;
-const float paddle_speed = 150.0f;
-const float paddle_boundary = (paddle_height / 2.0f) + (ball_diameter / 2.0f);
+// Simulation state, stepped by the main loop and drawn every frame
+Game PONG(SCREEN_WIDTH, SCREEN_HEIGHT);
 
-glm::vec2 paddle_offsets[2];
-glm::vec2 ball_offset;
-
-const float ball_min_velocity = 20.0f;
-const float ball_max_velocity = 300.0f;
-
-GLfloat paddle_velocity[2];
-
-// Random number generator
-int randomNumber(int min, int max, bool negative = false) {
-	if (!negative && (min < 0 || max < 0)) {
-		throw std::invalid_argument("CAN'T GENERATE NEGATIVE NUMBER IF NEGATIVES ARE NOT ALLOWED!");
-	}
-
-	if (negative) { 
-		return (rand() % 1) ? -(rand() % (max - min) + min) : (rand() % (max - min) + min);
-	}
-	return (rand() % (max - min) + min);
-}
-
-// Creates a circle using a 2D array for indices and precision (num_triangles AKA slices)
-void gen2DCircleArray(float*& vertices, unsigned int*& indices, unsigned int num_triangles, float radius = 1.0f) {
-	// Empty array for triangles points
-	vertices = new GLfloat[(num_triangles + 1) * 2];
-
-	// Center point
-	vertices[0] = 0.0f;
-	vertices[1] = 0.0f;
-
-	// Empty indice to make the triangles
-	indices = new GLuint[num_triangles * 3];
-
-	// Angle of every triangle for the circle
-	float theta = 0.0f;
-
-	// Assign values on the arrays
-	for (unsigned int i = 0; i < num_triangles; i++) {
-		vertices[(i + 1) * 2] = radius * cosf(theta);
-		vertices[(i + 1) * 2 + 1] = radius * sinf(theta);
-
-		indices[i * 3 + 0] = 0;
-		indices[i * 3 + 1] = i + 1;
-		indices[i * 3 + 2] = i + 2;
-
-		theta += 2 * PI / num_triangles;
-	}
-
-	indices[(num_triangles - 1) * 3 + 2] = 1;
-}
-
-void setOrthographicProjection(Shader shader_program,
+void setOrthographicProjection(Shader& shader_program,
 	int left, float right,
 	float bottom, float top,
 	float near, float far) {
@@ -88,10 +55,8 @@ void setOrthographicProjection(Shader shader_program,
 	{ -(right + left) / (right - left), -(top + bottom) / (top - bottom), -(far + near) / (far - near), 1.0f }
 	};
 
-	shader_program.Activate();
-
 	// Set the orthographic matrix to be used by the shader projection
-	glUniformMatrix4fv(glGetUniformLocation(shader_program.ID, "projection"), 1, GL_FALSE, &mat[0][0]);
+	shader_program.setMat4(PROJECTION_LOCATION, &mat[0][0]);
 };
 
 void framebufferSizeCallback(GLFWwindow* window, int width, int height) {
@@ -100,59 +65,30 @@ void framebufferSizeCallback(GLFWwindow* window, int width, int height) {
 	SCREEN_WIDTH = width;
 	SCREEN_HEIGHT = height;
 
-	// Set projection based on current windows size
-	setOrthographicProjection(SHADER, 0, width, 0, height, 0.0f, 1.0f);
+	// Set projection based on current windows size, a program still linking gets it
+	// from main once it is ready
+	if (SHADER.isReady()) {
+		setOrthographicProjection(SHADER, 0, width, 0, height, 0.0f, 1.0f);
+	}
 
 	// Update paddle position
-	paddle_offsets[1].x = width - 35.0f;
+	PONG.Resize(width, height);
 };
 
 void processInput(GLFWwindow* window) {
 	// Closes the windows when escape is pressed
 	if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS) glfwSetWindowShouldClose(window, true);
 
-	paddle_velocity[0] = 0.0f;
-	paddle_velocity[1] = 0.0f;
-
 	// Left paddle
-	if (glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS) {
-		if (paddle_offsets[0].y < SCREEN_HEIGHT - paddle_boundary) {
-			paddle_velocity[0] = paddle_speed;
-		}
-		else {
-			paddle_offsets[0].y = SCREEN_HEIGHT - paddle_boundary;
-		}
-	};
-	if (glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS) {
-		if (paddle_offsets[0].y > paddle_boundary) {
-			paddle_velocity[0] = -paddle_speed;
-		}
-		else {
-			paddle_offsets[0].y = paddle_boundary;
-		}
-	};
+	PONG.keys[KEY_LEFT_UP] = glfwGetKey(window, GLFW_KEY_W) == GLFW_PRESS;
+	PONG.keys[KEY_LEFT_DOWN] = glfwGetKey(window, GLFW_KEY_S) == GLFW_PRESS;
 
 	// Right paddle
-	if (glfwGetKey(window, GLFW_KEY_UP) == GLFW_PRESS) { 
-		if (paddle_offsets[1].y < SCREEN_HEIGHT - paddle_boundary) {
-			paddle_velocity[1] = paddle_speed;
-		}
-		else {
-			paddle_offsets[1].y = SCREEN_HEIGHT - paddle_boundary;
-		}
-	};
-
-	if (glfwGetKey(window, GLFW_KEY_DOWN) == GLFW_PRESS) {
-		if (paddle_offsets[1].y > paddle_boundary) {
-			paddle_velocity[1] = -paddle_speed;
-		}
-		else {
-			paddle_offsets[1].y = paddle_boundary;
-		}
-	};
+	PONG.keys[KEY_RIGHT_UP] = glfwGetKey(window, GLFW_KEY_UP) == GLFW_PRESS;
+	PONG.keys[KEY_RIGHT_DOWN] = glfwGetKey(window, GLFW_KEY_DOWN) == GLFW_PRESS;
 };
 
-int main() {
+int main(int argc, char** argv) {
 		// Initialize OpenGL version 4.6 
 	glfwInit();
 	glfwWindowHint(GLFW_CONTEXT_VERSION_MAJOR, 4);
@@ -179,223 +115,152 @@ int main() {
 		return -1;
 	}
 
-	// Generates the shader object using vertex and fragment shader files
-	SHADER.createShader("default.vert", "default.frag");
-	setOrthographicProjection(SHADER, 0, SCREEN_WIDTH, 0, SCREEN_HEIGHT, 0.0f, 1.0f);
+	glfwSwapInterval(SWAP_INTERVAL);
+
+	// PongGL --buffer-benchmark, compares buffer update strategies and exits
+	if (argc > 1 && std::string(argv[1]) == "--buffer-benchmark") {
+		benchmarkBufferUpdates();
+
+		glfwDestroyWindow(window);
+		glfwTerminate();
+		return 0;
+	}
+
+	// Generates the shader object using vertex and fragment shader files, the driver compiles
+	// in the background where it can while the rest is set up
+	enableParallelShaderCompile((GLADloadproc)glfwGetProcAddress);
+	SHADER.beginShader("default.vert", "default.frag");
+
+	// Shape edges are anti-aliased through alpha coverage
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
 
 	// ***************
-	// **	PADDLE	**
+	// **	GEOMETRY	**
 	// ***************
-	
-	GLfloat paddle_vertices[] = {
-		 0.5f,  0.5f,
-		-0.5f,  0.5f,
-		-0.5f, -0.5f,
-		 0.5f, -0.5f
-	};
 
-	GLuint paddle_indices[] = {
-		0, 1, 2,
-		2, 3 ,0
+	// One command per shape, base_instance picks its instances: ball (0) and paddles (1, 2)
+	DrawElementsCommand commands[] = {
+		{ (GLuint)quad_index_count, 1, 0, 0, 0 },
+		{ (GLuint)quad_index_count, 2, 0, 0, 1 }
 	};
+	const GLsizei command_count = sizeof(commands) / sizeof(commands[0]);
+	const unsigned int instance_count = 3;
 
-	paddle_offsets[0] = { 35.0f, SCREEN_HEIGHT / 2.0f };
-	paddle_offsets[1] = { SCREEN_WIDTH - 35.0f, SCREEN_HEIGHT / 2.0f };
+	// The vertex shader pulls each instance from a storage buffer, only positions are attributes
+	VAO shape_vao;
 
-	glm::vec2 paddle_sizes = { paddle_width, paddle_height };
+	GpuBuffer<GLfloat> position_vbo(quad_vertex_floats, BUFFER_STATIC, quad_vertices);
+	GpuBuffer<PackedInstance> instance_ssbo(instance_count, BUFFER_PERSISTENT);
 
-	VAO paddle_vao;
-	paddle_vao.Bind();
+	EBO shape_ebo(quad_indices, sizeof(quad_indices));
 
-	VBO paddle_position_vbo(paddle_vertices, sizeof(paddle_vertices), GL_STATIC_DRAW);
-	VBO paddle_offset_vbo(paddle_offsets, sizeof(paddle_offsets), GL_DYNAMIC_DRAW);
-	VBO paddle_size_vbo(&paddle_sizes, sizeof(paddle_sizes), GL_STATIC_DRAW);
+	IndirectBuffer command_buffer(commands, sizeof(commands));
 
-	EBO paddle_ebo(paddle_indices, sizeof(paddle_indices));
-	paddle_ebo.Bind();
-
-	paddle_vao.linkAttrib(paddle_position_vbo, 0, 2, GL_FLOAT, 2 * sizeof(GLfloat), (void*)0, 0);
-	paddle_vao.linkAttrib(paddle_offset_vbo, 1, 2, GL_FLOAT, 2 * sizeof(GLfloat), (void*)0, 1);
-	paddle_vao.linkAttrib(paddle_size_vbo, 2, 2, GL_FLOAT, 2 * sizeof(GLfloat), (void*)0, 2);
-
-	paddle_vao.Unbind();
-	paddle_position_vbo.Unbind();
-	paddle_offset_vbo.Unbind();
-	paddle_size_vbo.Unbind();
-	paddle_ebo.Unbind();
+	shape_vao.linkAttrib(position_vbo, 0, 2, GL_FLOAT, 2 * sizeof(GLfloat), (void*)0, 0);
+	shape_vao.linkElements(shape_ebo);
 
 	// ***************
-	// **	BALL	**
+	// **	SKINS	**
 	// ***************
 
-	// Ball variables
-	srand(time(0));
-	glm::vec2 ball_velocity = { randomNumber(50, 150, true), randomNumber(0, 150, true) };
-	
-	GLfloat* ball_vertices;
-	GLuint* ball_indices;
-	unsigned int num_triangles = 15; // Precision
+	// Optional skin pack, packed into one atlas so skinned shapes still draw in one call.
+	// Decoded on worker threads and streamed in over the first frames
+	WorkStealingPool loader_pool;
+	TextureLoader loader(loader_pool);
+	TextureAtlas skins;
 
-	// Assign values for the ball's info
-	gen2DCircleArray(ball_vertices, ball_indices, num_triangles, 0.5f);
+	// Baked skins (PongHeadless --bake) are preferred, they need no decoding
+	const std::string skin_files[] = { "skins/ball", "skins/paddle" };
+	const AtlasEntry untextured = { glm::vec4(0.0f, 0.0f, 1.0f, 1.0f), instance_untextured };
+	int skin_ids[2] = { -1, -1 };
 
-	// More ball informations
-	ball_offset = { SCREEN_WIDTH / 2.0f, SCREEN_HEIGHT / 2.0f };
+	for (int i = 0; i < 2; i++) {
+		if (std::ifstream(skin_files[i] + ".ptex")) skin_ids[i] = (int)skins.Add(skin_files[i] + ".ptex");
+		else if (std::ifstream(skin_files[i] + ".png")) skin_ids[i] = (int)skins.Add(skin_files[i] + ".png");
+	}
 
-	glm::vec2 ball_size = { ball_diameter, ball_diameter };
+	if (skin_ids[0] >= 0 || skin_ids[1] >= 0) {
+		skins.Build(&loader);
+	}
 
-	// Generates ball Vertex Array Object and binds it
-	VAO ball_vao;
-	ball_vao.Bind();
+	// Keeps presenting frames until every program has linked
+	while (!SHADER.isReady() && !glfwWindowShouldClose(window)) {
+		glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
+		glClear(GL_COLOR_BUFFER_BIT);
 
-	// Generates ball Vertex Buffer Objects and binds them
-	VBO ball_position_vbo(ball_vertices, 2 * (num_triangles + 1) * sizeof(GLfloat), GL_STATIC_DRAW);
-	VBO ball_offset_vbo(&ball_offset, sizeof(ball_offset), GL_DYNAMIC_DRAW);
-	VBO ball_size_vbo(&ball_size, sizeof(ball_size), GL_DYNAMIC_DRAW);
+		glfwSwapBuffers(window);
+		glfwPollEvents();
+	}
 
-	// Generates Element Buffer Object and binds it
-	EBO ball_ebo(ball_indices, 3 * num_triangles * sizeof(GLfloat));
-	ball_ebo.Bind();
+	SHADER.finishShader();
+	PROJECTION_LOCATION = SHADER.uniformLocation("projection");
+	setOrthographicProjection(SHADER, 0, SCREEN_WIDTH, 0, SCREEN_HEIGHT, 0.0f, 1.0f);
 
-	// Links all of ball's VBOs to it's VAO
-	ball_vao.linkAttrib(ball_position_vbo, 0, 2, GL_FLOAT, 2 * sizeof(GLfloat), (void*)0, 0);
-	ball_vao.linkAttrib(ball_offset_vbo, 1, 2, GL_FLOAT, 2 * sizeof(GLfloat), (void*)0, 1);
-	ball_vao.linkAttrib(ball_size_vbo, 2, 2, GL_FLOAT, 2 * sizeof(GLfloat), (void*)0, 2);
+	// PongGL --sprite-benchmark, draws masses of balls through SpriteBatch and exits
+	if (argc > 1 && std::string(argv[1]) == "--sprite-benchmark") {
+		benchmarkSprites(window, SHADER, SWAP_INTERVAL);
+		glfwSetWindowShouldClose(window, true);
+	}
 
-	// Unbind all previous objects
-	ball_vao.Unbind();
-	ball_position_vbo.Unbind();
-	ball_offset_vbo.Unbind();
-	ball_size_vbo.Unbind();
-	ball_ebo.Unbind();
+	// PongGL --readback-benchmark, times offscreen frames read back with and without a PBO ring
+	if (argc > 1 && std::string(argv[1]) == "--readback-benchmark") {
+		benchmarkReadback(window, SHADER, SWAP_INTERVAL);
+		glfwSetWindowShouldClose(window, true);
+	}
 
-	// Time elapse, used to stabilyze movement across different framerates
-	float dt = 0.0f, last_frame = 0.0f;
+	// Scores, laid out again only when they change
+	TextRenderer text;
+	const float score_height = 28.0f;
+	unsigned int score_texts[2] = {
+		text.AddText(glm::vec2(0.0f), score_height, 4),
+		text.AddText(glm::vec2(0.0f), score_height, 4)
+	};
 
-	// Collision frames
-	const int collision_threshold = 3;
-	int collision_cooldown = 0;
+	// Seeds serve velocities and starts the match
+	PONG.seed = (uint64_t)time(0);
+	PONG.Init();
 
-	// Which side scored, left (0) or right (1);
-	bool winner = 0;
+	// Fixed simulation step, frames draw between the last two simulated states
+	FixedTimestep timestep(SIMULATION_TICK_NS);
+	float dt = timestep.TickSeconds();
 
-	// Main program loop
-	while (!glfwWindowShouldClose(window)) {
-		// Time elapsed since last frame
-		float current_frame = (float)glfwGetTime();
-		dt = current_frame - last_frame;
-		last_frame = current_frame;
+	glm::vec2 previous_ball_offset = PONG.ball_offset;
+	glm::vec2 previous_paddle_offsets[2] = { PONG.paddle_offsets[0], PONG.paddle_offsets[1] };
 
-		bool reset = false;
+	// GL calls issued and skipped by the state cache, shown in the title once a second
+	GLState::Counters gl_calls = { 0, 0 };
+	unsigned int counted_frames = 0;
+	uint64_t last_report = monotonicNanoseconds();
 
+	// Main program loop
+	while (!glfwWindowShouldClose(window)) {
 		processInput(window);
 
-		// *******************
-		// **	COLLISIONS	**
-		// *******************
+		// Steps the simulation as many ticks as real time allows
+		for (unsigned int ticks = timestep.Advance(); ticks > 0; ticks--) {
+			unsigned int rallies = PONG.rallies;
 
-		// Collision with top or bottom wall
-		if (ball_offset.y - ball_radius <= 0 || ball_offset.y + ball_radius >= SCREEN_HEIGHT) {
-			ball_velocity.y *= -1;
+			previous_ball_offset = PONG.ball_offset;
+			previous_paddle_offsets[0] = PONG.paddle_offsets[0];
+			previous_paddle_offsets[1] = PONG.paddle_offsets[1];
 
-			float push = 0.1f * (ball_offset.y > SCREEN_HEIGHT / 2 ? -1 : 1);
-			ball_offset.y += push;
-		}
+			PONG.ProcessInput();
+			PONG.Update(dt);
 
-		// Collision with left wall 
-		if (ball_offset.x - ball_radius <= 0) {
-			winner = 0;
-			reset = true;
-		}
-
-		// Collision with right wall 
-		if (ball_offset.x + ball_radius >= SCREEN_WIDTH) {
-			winner = 1;
-			reset = true;
-		}
-
-		// Centers ball and reset velocity
-		if (reset) {
-			if (winner) {
-				ball_velocity = { -randomNumber(50, 150), randomNumber(0, 150, true) };
-			}
-			else {
-				ball_velocity = { randomNumber(50, 150), randomNumber(0, 150, true) };
-			}
-
-			ball_offset.x = SCREEN_WIDTH / 2.0f;
-			ball_offset.y = SCREEN_HEIGHT / 2.0f;
-		}
-
-		// Paddle collision
-		if (collision_cooldown > 0) {
-			collision_cooldown--;
-		}
-
-		if (collision_cooldown == 0) {
-			//Checks for left (0) and right (1) paddle
-			for (int lr = 0; lr < 2; lr++) {
-				// Calculate distance vector
-				glm::vec2 distance = {
-					std::abs(ball_offset.x - paddle_offsets[lr].x) - (paddle_width / 2 + ball_radius),
-					std::abs(ball_offset.y - paddle_offsets[lr].y) - (paddle_height / 2 + ball_radius)
-				};
-
-				// If both distances are negative the ball has a collision
-				if (distance.x < 0 && distance.y < 0) {
-					// Determine which side was hit
-					if (distance.x > distance.y) {
-						// Horizontal collision (left/right of paddle)
-						ball_velocity.x *= -1;
-
-						// Push ball out to prevent sticking
-						float push = (distance.x + 0.1f) * (ball_offset.x < paddle_offsets[lr].x ? -1 : 1);
-						ball_offset.x += push;
-					}
-					else {
-						// Vertical collision (top/bottom of paddle)
-						ball_velocity.y *= -1;
-					
-						// Push ball out to prevent sticking
-						float push = (distance.y + 0.1f) * (ball_offset.y < paddle_offsets[lr].y ? -1 : 1);
-						ball_offset.y += push;
-					}
-
-					// Speed up ball
-					ball_velocity.x *= 1.05f;
-					ball_velocity.y += 0.5f * paddle_velocity[lr];
-
-					// Checks for ball minimum and maximum velocities
-					if (std::abs(ball_velocity.y) < ball_min_velocity) {
-						ball_velocity.y = (ball_velocity.y > 0) ? ball_min_velocity : -ball_min_velocity;
-					}
-
-					if (std::abs(ball_velocity.y) > ball_max_velocity) {
-						ball_velocity.y = (ball_velocity.y > 0) ? ball_max_velocity : -ball_max_velocity;
-					}
-
-					if (std::abs(ball_velocity.x) < ball_min_velocity) {
-						ball_velocity.x = (ball_velocity.x > 0) ? ball_min_velocity : -ball_min_velocity;
-					}
-
-					if (std::abs(ball_velocity.x) > ball_max_velocity) {
-						ball_velocity.x = (ball_velocity.x > 0) ? ball_max_velocity : -ball_max_velocity;
-					}
-
-					// Activate cooldown
-					collision_cooldown = collision_threshold;
-					break; //If collided with left paddle, ignore chech for right paddle
-				}
+			// A serve teleports the ball to the center, don't draw it sliding there
+			if (PONG.rallies != rallies) {
+				previous_ball_offset = PONG.ball_offset;
 			}
 		}
 
-		// Updates paddles positions
-		paddle_offsets[0].y += paddle_velocity[0] * dt;
-		paddle_offsets[1].y += paddle_velocity[1] * dt;
-
-		// Updates ball position
-		ball_offset.x += ball_velocity.x * dt;
-		ball_offset.y += ball_velocity.y * dt;
+		// Blends the last two states by how far real time is into the next tick
+		float alpha = timestep.Alpha();
+		glm::vec2 ball_offset = glm::mix(previous_ball_offset, PONG.ball_offset, alpha);
+		glm::vec2 paddle_offsets[2] = {
+			glm::mix(previous_paddle_offsets[0], PONG.paddle_offsets[0], alpha),
+			glm::mix(previous_paddle_offsets[1], PONG.paddle_offsets[1], alpha)
+		};
 
 		// *******************
 		// **	GRAPHICS	**
@@ -408,20 +273,53 @@ int main() {
 		// Activates render/shader object
 		SHADER.Activate();
 
-		// Updates data in GPU
-		ball_offset_vbo.Bind();
-		glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(ball_offset), &ball_offset);
-		
-		paddle_offset_vbo.Bind();
-		glBufferSubData(GL_ARRAY_BUFFER, 0, sizeof(paddle_offsets), paddle_offsets);
+		// Skins show up once the whole pack has been uploaded
+		loader.Update();
+		bool skinned = loader.Pending() == 0;
+		const AtlasEntry& ball_skin = skinned && skin_ids[0] >= 0 ? skins.entries[skin_ids[0]] : untextured;
+		const AtlasEntry& paddle_skin = skinned && skin_ids[1] >= 0 ? skins.entries[skin_ids[1]] : untextured;
+
+		GLState::ActiveTexture(GL_TEXTURE0);
+		skins.texture.Bind();
+
+		// Writes instances straight into this frame's region of the mapped buffer
+		PackedInstance* instances = instance_ssbo.Next();
+		instances[0] = packInstance(ball_offset, glm::vec2(ball_diameter), glm::vec3(1.0f), SHAPE_CIRCLE, ball_skin.uv, ball_skin.layer);
+		instances[1] = packInstance(paddle_offsets[0], glm::vec2(paddle_width, paddle_height), glm::vec3(1.0f), SHAPE_BOX, paddle_skin.uv, paddle_skin.layer);
+		instances[2] = packInstance(paddle_offsets[1], glm::vec2(paddle_width, paddle_height), glm::vec3(1.0f), SHAPE_BOX, paddle_skin.uv, paddle_skin.layer);
+
+		// Draws every shape with a single call
+		GLState::BindBufferRange(GL_SHADER_STORAGE_BUFFER, 0, instance_ssbo.ID, instance_ssbo.Offset(), instance_count * sizeof(PackedInstance));
+		shape_vao.Bind();
 
-		// Draw the ball on screen
-		ball_vao.Bind();
-		glDrawElementsInstanced(GL_TRIANGLES, 3 * num_triangles, GL_UNSIGNED_INT, 0, 1);
+		command_buffer.Bind();
+		glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_INT, 0, command_count, 0);
 
-		// Draw paddles on screen
-		paddle_vao.Bind();
-		glDrawElementsInstanced(GL_TRIANGLES, 3 * 2, GL_UNSIGNED_INT, 0, 2);
+		// The region is free again once the GPU has finished this draw
+		instance_ssbo.Fence();
+
+		// Every score in one more draw
+		for (int lr = 0; lr < 2; lr++) {
+			text.SetText(score_texts[lr], std::to_string(PONG.score[lr]));
+			text.SetPosition(score_texts[lr], glm::vec2(SCREEN_WIDTH * (lr == 0 ? 0.25f : 0.75f), SCREEN_HEIGHT - score_height - 20.0f));
+		}
+		text.Draw();
+
+		GLState::Counters frame_calls = GLState::Frame();
+		gl_calls.issued += frame_calls.issued;
+		gl_calls.avoided += frame_calls.avoided;
+		counted_frames++;
+
+		if (monotonicNanoseconds() - last_report >= 1000000000ull) {
+			std::string title = "PongGL - GL calls per frame: " + std::to_string(gl_calls.issued / counted_frames) +
+				" issued, " + std::to_string(gl_calls.avoided / counted_frames) + " avoided";
+			glfwSetWindowTitle(window, title.c_str());
+
+			gl_calls.issued = 0;
+			gl_calls.avoided = 0;
+			counted_frames = 0;
+			last_report = monotonicNanoseconds();
+		}
 
 		// Swap frames
 		glfwSwapBuffers(window);
@@ -429,19 +327,17 @@ int main() {
 	}
 
 	// Clears up everything
-	ball_vao.Delete();
-	ball_ebo.Delete();
+	shape_vao.Delete();
+	shape_ebo.Delete();
+	command_buffer.Delete();
 
-	ball_position_vbo.Delete();
-	ball_offset_vbo.Delete();
-	ball_size_vbo.Delete();
+	position_vbo.Delete();
+	instance_ssbo.Delete();
 
-	paddle_vao.Delete();
-	paddle_ebo.Delete();
-	
-	paddle_position_vbo.Delete();
-	paddle_offset_vbo.Delete();
-	paddle_size_vbo.Delete();
+	text.Delete();
+
+	loader.Delete();
+	skins.Delete();
 
 	SHADER.Delete();
 